@@ -0,0 +1,241 @@
+#include "Benchmark.h"
+#include "Results.h"
+#include "MathHeaders/Instrument.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace Bench {
+	namespace {
+		struct Entry {
+			std::string name;
+			Function fn;
+			bool manual;
+		};
+
+		std::vector<Entry>& Entries() {
+			static std::vector<Entry> entries;
+			return entries;
+		}
+
+		struct Options {
+			double minTimeNs = 200e6;
+			std::vector<std::string> filters;
+			bool list = false;
+			int repetitions = 1;
+			std::string jsonPath;
+			std::string baselinePath;
+			std::string tracePath;
+			double threshold = 0.25;
+		};
+
+		// comma separated list of patterns, any of which selects a benchmark (see Matches)
+		std::vector<std::string> SplitFilter(const std::string& text) {
+			std::vector<std::string> parts;
+			size_t start = 0;
+			while (start <= text.size()) {
+				size_t comma = text.find(',', start);
+				if (comma == std::string::npos) {
+					comma = text.size();
+				}
+				if (comma > start) {
+					parts.push_back(text.substr(start, comma - start));
+				}
+				start = comma + 1;
+			}
+			return parts;
+		}
+
+		// a pattern matches any name containing it; a leading ^ anchors it to the start of the name
+		// and a trailing $ to the end, so ^Matrix4_Multiply$ leaves out Matrix4_MultiplyArray_Warm
+		bool Matches(const std::string& name, const std::string& filter) {
+			bool atStart = !filter.empty() && filter.front() == '^';
+			bool atEnd = filter.size() > (atStart ? 1u : 0u) && filter.back() == '$';
+			std::string text = filter.substr(atStart ? 1 : 0, filter.size() - (atStart ? 1 : 0) - (atEnd ? 1 : 0));
+			if (atStart && atEnd) {
+				return name == text;
+			}
+			if (atStart) {
+				return name.compare(0, text.size(), text) == 0;
+			}
+			if (atEnd) {
+				return name.size() >= text.size() && name.compare(name.size() - text.size(), text.size(), text) == 0;
+			}
+			return name.find(text) != std::string::npos;
+		}
+
+		// manual benchmarks only run when a filter names them
+		bool Selected(const Options& options, const std::string& name, bool manual = false) {
+			if (options.filters.empty()) {
+				return !manual;
+			}
+			for (const std::string& filter : options.filters) {
+				if (Matches(name, filter)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		Options ParseOptions(int argc, char** argv) {
+			Options options;
+			for (int i = 1; i < argc; ++i) {
+				if (std::strcmp(argv[i], "--quick") == 0) {
+					options.minTimeNs = 1e6;
+				}
+				else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+					options.minTimeNs = std::atof(argv[++i]) * 1e6;
+				}
+				else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+					options.filters = SplitFilter(argv[++i]);
+				}
+				else if (std::strcmp(argv[i], "--list") == 0) {
+					options.list = true;
+				}
+				else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+					options.repetitions = std::max(1, std::atoi(argv[++i]));
+				}
+				else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+					options.jsonPath = argv[++i];
+				}
+				else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+					options.baselinePath = argv[++i];
+				}
+				else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+					options.tracePath = argv[++i];
+				}
+				else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+					options.threshold = std::atof(argv[++i]) / 100.0;
+				}
+				else {
+					std::printf("usage: %s [--filter a,b,...] [--min-time ms] [--quick] [--list]\n"
+						"          [--repetitions n] [--json out.json] [--baseline base.json] [--threshold percent]\n"
+						"          [--trace out.json]\n", argv[0]);
+					std::exit(1);
+				}
+			}
+			return options;
+		}
+
+		// grow the iteration count until one run lasts at least minTimeNs
+		State Measure(const Function& fn, double minTimeNs) {
+			size_t iterations = 1;
+			for (;;) {
+				State state(iterations);
+				fn(state);
+				double elapsed = state.ElapsedNs();
+				if (elapsed >= minTimeNs || iterations >= (size_t(1) << 40)) {
+					return state;
+				}
+				double scale = elapsed > 0 ? minTimeNs * 1.2 / elapsed : 100.0;
+				scale = scale < 2.0 ? 2.0 : (scale > 100.0 ? 100.0 : scale);
+				iterations = static_cast<size_t>(iterations * scale);
+			}
+		}
+
+		void PrintThroughput(double perSecond, const char* unit) {
+			const char* prefixes[] = { "", "k", "M", "G", "T" };
+			int p = 0;
+			while (perSecond >= 1000.0 && p < 4) {
+				perSecond /= 1000.0;
+				++p;
+			}
+			std::printf("  %8.2f %s%s/s", perSecond, prefixes[p], unit);
+		}
+	}
+
+	void Register(const std::string& name, Function fn, bool manual) {
+		Entries().push_back({ name, std::move(fn), manual });
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+
+	std::map<std::string, double> baseline;
+	if (!options.baselinePath.empty() && !Bench::ReadBaseline(options.baselinePath, baseline)) {
+		std::printf("could not read baseline %s\n", options.baselinePath.c_str());
+		return 1;
+	}
+
+#if MATHCLASSES_INSTRUMENT
+	MathClasses::Instrument::SetTracing(!options.tracePath.empty());
+#else
+	if (!options.tracePath.empty()) {
+		std::printf("--trace needs a build with MATHCLASSES_INSTRUMENT, ignoring it\n");
+	}
+#endif
+
+	std::vector<Bench::Result> results;
+	if (!options.list) {
+		std::printf("%-44s %14s %14s\n", "Benchmark", "Iterations", "ns/op");
+	}
+	for (const Bench::Entry& entry : Bench::Entries()) {
+		if (!Bench::Selected(options, entry.name, entry.manual)) {
+			continue;
+		}
+		if (options.list) {
+			std::printf("%s\n", entry.name.c_str());
+			continue;
+		}
+
+		// the first repetition calibrates the iteration count, the rest reuse it
+		Bench::State state = Bench::Measure(entry.fn, options.minTimeNs);
+		Bench::Result result;
+		result.name = entry.name;
+		result.iterations = state.Iterations();
+		result.samples.push_back(state.ElapsedNs() / state.Iterations());
+		for (int rep = 1; rep < options.repetitions; ++rep) {
+			Bench::State again(result.iterations);
+			entry.fn(again);
+			result.samples.push_back(again.ElapsedNs() / again.Iterations());
+		}
+		Bench::Summarise(result);
+		results.push_back(result);
+
+		double nsPerOp = result.median;
+		std::printf("%-44s %14zu %14.3f", entry.name.c_str(), result.iterations, nsPerOp);
+		if (state.ItemsPerIteration() > 0) {
+			Bench::PrintThroughput(state.ItemsPerIteration() * 1e9 / nsPerOp, "items");
+		}
+		if (state.BytesPerIteration() > 0) {
+			Bench::PrintThroughput(state.BytesPerIteration() * 1e9 / nsPerOp, "B");
+		}
+		std::printf("\n");
+	}
+
+#if MATHCLASSES_INSTRUMENT
+	if (!options.list) {
+		std::printf("\n%-44s %14s\n", "Counter", "Calls");
+		for (int i = 0; i < static_cast<int>(MathClasses::Instrument::Counter::Count); ++i) {
+			auto counter = static_cast<MathClasses::Instrument::Counter>(i);
+			std::printf("%-44s %14llu\n", MathClasses::Instrument::Name(counter),
+				static_cast<unsigned long long>(MathClasses::Instrument::Total(counter)));
+		}
+	}
+	if (!options.tracePath.empty() && !MathClasses::Instrument::WriteChromeTrace(options.tracePath)) {
+		std::printf("could not write %s\n", options.tracePath.c_str());
+		return 1;
+	}
+#endif
+
+	if (!options.jsonPath.empty() && !Bench::WriteJson(options.jsonPath, results)) {
+		std::printf("could not write %s\n", options.jsonPath.c_str());
+		return 1;
+	}
+
+	if (!options.baselinePath.empty()) {
+		// baseline entries outside the filter were not run, so they are not missing
+		for (auto it = baseline.begin(); it != baseline.end();) {
+			it = Bench::Selected(options, it->first) ? std::next(it) : baseline.erase(it);
+		}
+		if (Bench::CompareToBaseline(results, baseline, options.threshold) > 0) {
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Bench
+{
+    // Keep the compiler from optimising away a value or assuming it is unchanged
+#if defined(_MSC_VER) && !defined(__clang__)
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        static const volatile void* sink;
+        sink = &value;
+        _ReadWriteBarrier();
+    }
+#else
+    template <typename T>
+    inline void DoNotOptimize(T& value)
+    {
+        asm volatile("" : "+m"(value) : : "memory");
+    }
+
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+#endif
+
+    class State
+    {
+    public:
+        explicit State(size_t iterations) : iterations(iterations) {}
+
+        size_t Iterations() const { return iterations; }
+
+        // Time body() called Iterations() times; anything before Run is untimed setup
+        template <typename F>
+        void Run(F&& body)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                body();
+            }
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        // Work done by one call of the body, used for throughput
+        void SetItemsPerIteration(double items) { itemsPerIteration = items; }
+        void SetBytesPerIteration(double bytes) { bytesPerIteration = bytes; }
+
+        double ElapsedNs() const { return std::chrono::duration<double, std::nano>(elapsed).count(); }
+        double ItemsPerIteration() const { return itemsPerIteration; }
+        double BytesPerIteration() const { return bytesPerIteration; }
+
+    private:
+        size_t iterations;
+        std::chrono::steady_clock::duration elapsed{};
+        double itemsPerIteration = 0;
+        double bytesPerIteration = 0;
+    };
+
+    using Function = std::function<void(State&)>;
+
+    // Add a benchmark to the global list. Manual ones are too big or too many for a full run
+    // and are skipped unless --filter selects them.
+    void Register(const std::string& name, Function fn, bool manual = false);
+
+    struct Registrar
+    {
+        Registrar(const char* name, Function fn) { Register(name, std::move(fn)); }
+    };
+}
+
+#define BENCHMARK(name) \
+    static void name(Bench::State& state); \
+    static Bench::Registrar name##Registrar(#name, name); \
+    static void name(Bench::State& state)
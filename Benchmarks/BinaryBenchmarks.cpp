@@ -0,0 +1,20 @@
+#include "Benchmark.h"
+#include "MathHeaders/BinaryArray.h"
+#include <vector>
+
+using MathClasses::Checksum64;
+
+// cost of the optional container checksum over a payload larger than the caches
+BENCHMARK(Binary_Checksum) {
+	std::vector<unsigned char> data(size_t(1) << 24);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<unsigned char>(i * 131);
+	}
+	state.SetBytesPerIteration(static_cast<double>(data.size()));
+	state.Run([&] {
+		Checksum64 hash;
+		hash.Update(data.data(), data.size());
+		uint64_t value = hash.Final();
+		Bench::DoNotOptimize(value);
+	});
+}
@@ -0,0 +1,168 @@
+#include "Benchmark.h"
+#include "MathHeaders/Colour.h"
+#include "MathHeaders/ColourHistogram.h"
+#include "MathHeaders/ColourSpace.h"
+#include "MathHeaders/Resample.h"
+#include "MathHeaders/Tonemap.h"
+#include <vector>
+
+using MathClasses::Colour;
+
+namespace {
+	const size_t WarmCount = 1 << 12;
+	const size_t ColdCount = 1 << 24;
+
+	std::vector<Colour> MakeColours(size_t count) {
+		std::vector<Colour> c(count);
+		for (size_t i = 0; i < count; ++i) {
+			c[i].colour = static_cast<uint32_t>(i * 2654435761u);
+		}
+		return c;
+	}
+}
+
+#define COLOUR_EXPR(name, expr) \
+	BENCHMARK(name) { \
+		Colour a(200, 100, 50, 255), b(10, 120, 250, 128); \
+		float t = 0.25f; \
+		state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); Bench::DoNotOptimize(t); \
+			auto r = expr; Bench::DoNotOptimize(r); }); \
+	}
+
+#define COLOUR_STMT(name, stmt) \
+	BENCHMARK(name) { \
+		Colour a(200, 100, 50, 255), b(10, 120, 250, 128); \
+		state.Run([&] { Bench::DoNotOptimize(b); stmt; Bench::DoNotOptimize(a); }); \
+	}
+
+COLOUR_EXPR(Colour_Construct, Colour(b.GetRed(), 2, 3, 4))
+COLOUR_EXPR(Colour_GetRed, a.GetRed())
+COLOUR_EXPR(Colour_GetGreen, a.GetGreen())
+COLOUR_EXPR(Colour_GetBlue, a.GetBlue())
+COLOUR_EXPR(Colour_GetAlpha, a.GetAlpha())
+COLOUR_EXPR(Colour_Equal, a == b)
+COLOUR_EXPR(Colour_NotEqual, a != b)
+COLOUR_EXPR(Colour_Add, a + b)
+COLOUR_EXPR(Colour_Subtract, a - b)
+COLOUR_EXPR(Colour_Scale, a * t)
+COLOUR_EXPR(Colour_Lerp, Colour::Lerp(a, b, t))
+COLOUR_EXPR(Colour_ToHSV, MathClasses::ToHSV(a))
+COLOUR_EXPR(Colour_ToHSL, MathClasses::ToHSL(a))
+COLOUR_EXPR(Colour_FromHSV, MathClasses::FromHSV(MathClasses::ColourHSV{ t * 360.0f, t, 0.5f, 1.0f }))
+COLOUR_EXPR(Colour_FromHSL, MathClasses::FromHSL(MathClasses::ColourHSL{ t * 360.0f, t, 0.5f, 1.0f }))
+COLOUR_STMT(Colour_SetRed, a.SetRed(b.GetAlpha()))
+COLOUR_STMT(Colour_SetGreen, a.SetGreen(b.GetAlpha()))
+COLOUR_STMT(Colour_SetBlue, a.SetBlue(b.GetAlpha()))
+COLOUR_STMT(Colour_SetAlpha, a.SetAlpha(b.GetRed()))
+
+// batch blends, warm (in cache) and cold (streamed from memory)
+template <typename Fn>
+static void ColourBatch(Bench::State& state, size_t count, Fn fn) {
+	std::vector<Colour> a = MakeColours(count), b = MakeColours(count), out(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Colour) * 3));
+	state.Run([&] {
+		fn(a.data(), b.data(), out.data(), count);
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+BENCHMARK(Colour_AddSaturate_Warm) { ColourBatch(state, WarmCount, MathClasses::AddSaturate); }
+BENCHMARK(Colour_AddSaturate_Cold) { ColourBatch(state, ColdCount, MathClasses::AddSaturate); }
+BENCHMARK(Colour_Average_Warm) { ColourBatch(state, WarmCount, MathClasses::Average); }
+BENCHMARK(Colour_CrossFade_Warm) {
+	ColourBatch(state, WarmCount, [](const Colour* a, const Colour* b, Colour* out, size_t n) { MathClasses::CrossFade(a, b, out, n, 0.3f); });
+}
+BENCHMARK(Colour_CrossFade_Cold) {
+	ColourBatch(state, ColdCount, [](const Colour* a, const Colour* b, Colour* out, size_t n) { MathClasses::CrossFade(a, b, out, n, 0.3f); });
+}
+BENCHMARK(Colour_CrossFadeScalar_Warm) {
+	ColourBatch(state, WarmCount, [](const Colour* a, const Colour* b, Colour* out, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			out[i] = Colour::Lerp(a[i], b[i], 0.3f);
+		}
+	});
+}
+BENCHMARK(Colour_FillGradient_Warm) {
+	std::vector<Colour> out(WarmCount);
+	state.SetItemsPerIteration(static_cast<double>(WarmCount));
+	state.Run([&] {
+		MathClasses::FillGradient(out.data(), out.size(), Colour(0, 0, 0, 255), Colour(255, 128, 0, 255));
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+// HSV conversion: batch kernel against the single colour reference in a loop
+static void HSVBatch(Bench::State& state, size_t count, bool batch) {
+	std::vector<Colour> in = MakeColours(count), back(count);
+	std::vector<MathClasses::ColourHSV> hsv(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (batch) {
+			MathClasses::ToHSV(in.data(), hsv.data(), count);
+			MathClasses::FromHSV(hsv.data(), back.data(), count);
+		}
+		else {
+			for (size_t i = 0; i < count; ++i) {
+				back[i] = MathClasses::FromHSV(MathClasses::ToHSV(in[i]));
+			}
+		}
+		Bench::DoNotOptimize(back[0]);
+	});
+}
+
+BENCHMARK(Colour_HSVRoundTrip_Batch_Warm) { HSVBatch(state, WarmCount, true); }
+BENCHMARK(Colour_HSVRoundTrip_Scalar_Warm) { HSVBatch(state, WarmCount, false); }
+BENCHMARK(Colour_HSVRoundTrip_Batch_Cold) { HSVBatch(state, ColdCount, true); }
+BENCHMARK(Colour_HSVRoundTrip_Scalar_Cold) { HSVBatch(state, ColdCount, false); }
+
+BENCHMARK(Colour_Histogram_Cold) {
+	std::vector<Colour> in = MakeColours(ColdCount);
+	state.SetItemsPerIteration(static_cast<double>(ColdCount));
+	state.Run([&] {
+		MathClasses::ColourHistogram h = MathClasses::ColourHistogram::Build(in.data(), in.size());
+		Bench::DoNotOptimize(h.red[0]);
+	});
+}
+
+BENCHMARK(Colour_MapToPalette256) {
+	std::vector<Colour> in = MakeColours(1 << 16);
+	std::vector<Colour> palette = MathClasses::MakePaletteMedianCut(in.data(), in.size(), 256);
+	std::vector<uint8_t> indices(in.size());
+	state.SetItemsPerIteration(static_cast<double>(in.size()));
+	state.Run([&] {
+		MathClasses::MapToPalette(in.data(), in.size(), palette.data(), palette.size(), indices.data());
+		Bench::DoNotOptimize(indices[0]);
+	});
+}
+
+// image kernels report items as pixels, so items/s reads as pixels per second
+BENCHMARK(Colour_Tonemap1080p) {
+	const size_t width = 1920, height = 1080;
+	std::vector<float> hdr(width * height * 4, 0.75f);
+	std::vector<Colour> out(width * height);
+	MathClasses::TonemapSettings settings;
+	settings.curve = MathClasses::TonemapCurve::ACES;
+	settings.dither = true;
+	state.SetItemsPerIteration(static_cast<double>(width * height));
+	state.Run([&] {
+		MathClasses::TonemapToColour(hdr.data(), out.data(), width, height, settings);
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+static void ResampleImage(Bench::State& state, size_t srcWidth, size_t srcHeight, size_t dstWidth, size_t dstHeight,
+	MathClasses::ResampleFilter filter) {
+	std::vector<Colour> src = MakeColours(srcWidth * srcHeight), dst(dstWidth * dstHeight);
+	state.SetItemsPerIteration(static_cast<double>(dstWidth * dstHeight));
+	state.Run([&] {
+		MathClasses::Resample(src.data(), srcWidth, srcHeight, dst.data(), dstWidth, dstHeight, filter);
+		Bench::DoNotOptimize(dst[0]);
+	});
+}
+
+BENCHMARK(Colour_Resample_Box_Thumbnail) { ResampleImage(state, 1920, 1080, 240, 135, MathClasses::ResampleFilter::Box); }
+BENCHMARK(Colour_Resample_Bilinear_Thumbnail) { ResampleImage(state, 1920, 1080, 240, 135, MathClasses::ResampleFilter::Bilinear); }
+BENCHMARK(Colour_Resample_Lanczos3_Thumbnail) { ResampleImage(state, 1920, 1080, 240, 135, MathClasses::ResampleFilter::Lanczos3); }
+BENCHMARK(Colour_Resample_Bilinear_Preview) { ResampleImage(state, 480, 270, 1920, 1080, MathClasses::ResampleFilter::Bilinear); }
+BENCHMARK(Colour_Resample_Lanczos3_Preview) { ResampleImage(state, 480, 270, 1920, 1080, MathClasses::ResampleFilter::Lanczos3); }
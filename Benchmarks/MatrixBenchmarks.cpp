@@ -0,0 +1,519 @@
+#include "Benchmark.h"
+#include "MathHeaders/Compare.h"
+#include "MathHeaders/Matrix3.h"
+#include "MathHeaders/Matrix4.h"
+#include "MathHeaders/MatrixView.h"
+#include "MathHeaders/PaddedMatrix3.h"
+#include "MathHeaders/PrefixProduct.h"
+#include "MathHeaders/Skinning.h"
+#include "MathHeaders/SpriteBatch.h"
+#include "MathHeaders/VertexTransform.h"
+#include <cstddef>
+#include <vector>
+
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+
+namespace {
+	const size_t WarmCount = 1 << 8;
+	const size_t ColdCount = 1 << 21;
+
+	// FormatTo target, global so the writes cannot be dropped
+	char formatBuffer[512];
+
+	Matrix3 SampleMatrix3() {
+		return Matrix3::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix3::MakeScale(1.5f, 2.0f, 0.5f);
+	}
+
+	Matrix4 SampleMatrix4() {
+		return Matrix4::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f);
+	}
+}
+
+// expr evaluated once per iteration with a, b (matrices), v (vector) and f (float) reloaded
+#define MATRIX3_EXPR(name, expr) \
+	BENCHMARK(name) { \
+		Matrix3 a = SampleMatrix3(), b = SampleMatrix3().Transposed(); \
+		Vector3 v(1.0f, -2.0f, 0.5f); \
+		float f = 0.75f; \
+		state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); Bench::DoNotOptimize(v); Bench::DoNotOptimize(f); \
+			auto r = expr; Bench::DoNotOptimize(r); }); \
+	}
+
+#define MATRIX3_STMT(name, stmt) \
+	BENCHMARK(name) { \
+		Matrix3 a = SampleMatrix3(), b = SampleMatrix3().Transposed(); \
+		Vector3 v(1.0f, -2.0f, 0.5f); \
+		float f = 0.75f; \
+		state.Run([&] { Bench::DoNotOptimize(b); Bench::DoNotOptimize(v); Bench::DoNotOptimize(f); \
+			stmt; Bench::DoNotOptimize(a); }); \
+	}
+
+#define MATRIX4_EXPR(name, expr) \
+	BENCHMARK(name) { \
+		Matrix4 a = SampleMatrix4(), b = SampleMatrix4(); \
+		Vector3 v3(1.0f, -2.0f, 0.5f); \
+		Vector4 v(1.0f, -2.0f, 0.5f, 1.0f); \
+		float f = 0.75f; \
+		state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); Bench::DoNotOptimize(v); Bench::DoNotOptimize(v3); \
+			Bench::DoNotOptimize(f); auto r = expr; Bench::DoNotOptimize(r); }); \
+	}
+
+#define MATRIX4_STMT(name, stmt) \
+	BENCHMARK(name) { \
+		Matrix4 a = SampleMatrix4(), b = SampleMatrix4(); \
+		Vector4 v(1.0f, -2.0f, 0.5f, 1.0f); \
+		float f = 0.75f; \
+		state.Run([&] { Bench::DoNotOptimize(b); Bench::DoNotOptimize(v); Bench::DoNotOptimize(f); \
+			stmt; Bench::DoNotOptimize(a); }); \
+	}
+
+MATRIX3_EXPR(Matrix3_Construct, Matrix3(f, 0, 0, 0, f, 0, 0, 0, f))
+MATRIX3_EXPR(Matrix3_ConstructArray, Matrix3(&a.m1))
+MATRIX3_EXPR(Matrix3_Multiply, a * b)
+MATRIX3_EXPR(Matrix3_MultiplyVector, a * v)
+MATRIX3_EXPR(Matrix3_PointViaVector3, [&] { Vector3 r = a * Vector3(v.x, v.y, 1.0f); return MathClasses::Vector2(r.x, r.y); }())
+MATRIX3_EXPR(Matrix3_TransformPoint2D, a.TransformPoint2D(MathClasses::Vector2(v.x, v.y)))
+MATRIX3_EXPR(Matrix3_Determinant, a.Determinant())
+MATRIX3_EXPR(Matrix3_Inverted, a.Inverted())
+MATRIX3_EXPR(Matrix3_InvertedAffine2D, a.InvertedAffine2D())
+MATRIX3_EXPR(Matrix3_Transposed, a.Transposed())
+MATRIX3_EXPR(Matrix3_Equal, a == b)
+MATRIX3_EXPR(Matrix3_ToString, a.ToString())
+MATRIX3_EXPR(Matrix3_FormatTo, a.FormatTo(formatBuffer, sizeof(formatBuffer)))
+MATRIX3_EXPR(Matrix3_RoundToMat3, Matrix3::RoundToMat3(f, 6))
+MATRIX3_EXPR(Matrix3_MakeIdentity, Matrix3::MakeIdentity())
+MATRIX3_EXPR(Matrix3_MakeTranslation, Matrix3::MakeTranslation(f, v.y))
+MATRIX3_EXPR(Matrix3_MakeRotateX, Matrix3::MakeRotateX(f))
+MATRIX3_EXPR(Matrix3_MakeRotateY, Matrix3::MakeRotateY(f))
+MATRIX3_EXPR(Matrix3_MakeRotateZ, Matrix3::MakeRotateZ(f))
+MATRIX3_EXPR(Matrix3_MakeEuler, Matrix3::MakeEuler(f, v.x, v.y))
+MATRIX3_EXPR(Matrix3_MakeScale, Matrix3::MakeScale(f, v.x, v.y))
+MATRIX3_STMT(Matrix3_Set, a.Set(b))
+MATRIX3_STMT(Matrix3_SetScaled, a.SetScaled(v))
+MATRIX3_STMT(Matrix3_Scale, a.Set(b); a.Scale(v))
+MATRIX3_STMT(Matrix3_SetRotateX, a.SetRotateX(f))
+MATRIX3_STMT(Matrix3_SetRotateY, a.SetRotateY(f))
+MATRIX3_STMT(Matrix3_SetRotateZ, a.SetRotateZ(f))
+MATRIX3_STMT(Matrix3_RotateX, a.Set(b); a.RotateX(f))
+MATRIX3_STMT(Matrix3_RotateY, a.Set(b); a.RotateY(f))
+MATRIX3_STMT(Matrix3_RotateZ, a.Set(b); a.RotateZ(f))
+MATRIX3_STMT(Matrix3_SetRotated, a.SetRotated(f, v.x, v.y))
+MATRIX3_STMT(Matrix3_SetTranslation, a.SetTranslation(f, v.x))
+MATRIX3_STMT(Matrix3_Translate, a.Set(b); a.Translate(v))
+
+MATRIX4_EXPR(Matrix4_Construct, Matrix4(f, 0, 0, 0, 0, f, 0, 0, 0, 0, f, 0, 0, 0, 0, 1))
+MATRIX4_EXPR(Matrix4_ConstructArray, Matrix4(&a.m1))
+MATRIX4_EXPR(Matrix4_Multiply, a * b)
+MATRIX4_EXPR(Matrix4_MultiplyVector, a * v)
+MATRIX4_EXPR(Matrix4_PointViaVector4, [&] { Vector4 r = a * Vector4(v3.x, v3.y, v3.z, 1.0f); return Vector3(r.x, r.y, r.z); }())
+MATRIX4_EXPR(Matrix4_TransformPoint, a.TransformPoint(v3))
+MATRIX4_EXPR(Matrix4_TransformDirection, a.TransformDirection(v3))
+MATRIX4_EXPR(Matrix4_TransformPointProjective, a.TransformPointProjective(v3))
+MATRIX4_EXPR(Matrix4_Equal, a == b)
+MATRIX4_EXPR(Matrix4_NotEqual, a != b)
+MATRIX4_EXPR(Matrix4_Equals, a.Equals(b))
+MATRIX4_EXPR(Matrix4_ToString, a.ToString())
+MATRIX4_EXPR(Matrix4_FormatTo, a.FormatTo(formatBuffer, sizeof(formatBuffer)))
+MATRIX4_EXPR(Matrix4_RoundToMat4, Matrix4::RoundToMat4(f, 6))
+MATRIX4_EXPR(Matrix4_MakeIdentity, Matrix4::MakeIdentity())
+MATRIX4_EXPR(Matrix4_MakeTranslation, Matrix4::MakeTranslation(v3))
+MATRIX4_EXPR(Matrix4_MakeRotateX, Matrix4::MakeRotateX(f))
+MATRIX4_EXPR(Matrix4_MakeRotateY, Matrix4::MakeRotateY(f))
+MATRIX4_EXPR(Matrix4_MakeRotateZ, Matrix4::MakeRotateZ(f))
+MATRIX4_EXPR(Matrix4_MakeEuler, Matrix4::MakeEuler(f, v.x, v.y))
+MATRIX4_EXPR(Matrix4_MakeScale, Matrix4::MakeScale(v3))
+MATRIX4_STMT(Matrix4_Set, a.Set(b))
+MATRIX4_STMT(Matrix4_SetScaled, a.SetScaled(v))
+MATRIX4_STMT(Matrix4_Scale, a.Set(b); a.Scale(v))
+MATRIX4_STMT(Matrix4_SetRotateX, a.SetRotateX(f))
+MATRIX4_STMT(Matrix4_SetRotateY, a.SetRotateY(f))
+MATRIX4_STMT(Matrix4_SetRotateZ, a.SetRotateZ(f))
+MATRIX4_STMT(Matrix4_RotateX, a.Set(b); a.RotateX(f))
+MATRIX4_STMT(Matrix4_RotateY, a.Set(b); a.RotateY(f))
+MATRIX4_STMT(Matrix4_RotateZ, a.Set(b); a.RotateZ(f))
+MATRIX4_STMT(Matrix4_SetRotated, a.SetRotated(f, v.x, v.y))
+MATRIX4_STMT(Matrix4_SetTranslation, a.SetTranslation(f, v.x, v.y))
+MATRIX4_STMT(Matrix4_Translate, a.Set(b); a.Translate(v))
+
+// whole-array products, warm (in cache) and cold (streamed from memory)
+static void Matrix4MultiplyArray(Bench::State& state, size_t count) {
+	std::vector<Matrix4> a(count, SampleMatrix4()), out(count);
+	Matrix4 b = SampleMatrix4();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Matrix4) * 2));
+	state.Run([&] {
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = a[i] * b;
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+BENCHMARK(Matrix4_MultiplyArray_Warm) { Matrix4MultiplyArray(state, WarmCount); }
+BENCHMARK(Matrix4_MultiplyArray_Cold) { Matrix4MultiplyArray(state, ColdCount); }
+
+static void Matrix3MultiplyArray(Bench::State& state, size_t count) {
+	std::vector<Matrix3> a(count, SampleMatrix3()), out(count);
+	Matrix3 b = SampleMatrix3();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Matrix3) * 2));
+	state.Run([&] {
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = a[i] * b;
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+static void Matrix3InvertArray(Bench::State& state, size_t count, bool batch) {
+	std::vector<Matrix3> a(count, SampleMatrix3()), out(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (batch) {
+			Matrix3::Invert(a.data(), out.data(), count);
+		} else {
+			for (size_t i = 0; i < count; ++i) {
+				out[i] = a[i].Inverted();
+			}
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+// near-equality of matrix pairs: Equals one at a time against the bitmask batch
+static void CompareArray(Bench::State& state, size_t count, const MathClasses::Tolerance* tolerance) {
+	std::vector<Matrix4> a(count, SampleMatrix4()), b(count, SampleMatrix4());
+	std::vector<uint64_t> mask((count + 63) / 64);
+	std::vector<char> equal(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Matrix4) * 2));
+	state.Run([&] {
+		if (tolerance) {
+			Bench::DoNotOptimize(MathClasses::Compare(a.data(), b.data(), count, *tolerance, mask.data()));
+		} else {
+			for (size_t i = 0; i < count; ++i) {
+				equal[i] = a[i].Equals(b[i]);
+			}
+			Bench::DoNotOptimize(equal[0]);
+		}
+	});
+}
+
+static const MathClasses::Tolerance AbsoluteTolerance = MathClasses::Tolerance::Absolute();
+static const MathClasses::Tolerance UlpTolerance = MathClasses::Tolerance::Ulps();
+
+BENCHMARK(Matrix4_EqualsArray_Warm) { CompareArray(state, WarmCount, nullptr); }
+BENCHMARK(Matrix4_CompareAbsolute_Warm) { CompareArray(state, WarmCount, &AbsoluteTolerance); }
+BENCHMARK(Matrix4_CompareUlps_Warm) { CompareArray(state, WarmCount, &UlpTolerance); }
+BENCHMARK(Matrix4_CompareAbsolute_Cold) { CompareArray(state, ColdCount, &AbsoluteTolerance); }
+
+BENCHMARK(Matrix3_MultiplyArray_Warm) { Matrix3MultiplyArray(state, WarmCount); }
+BENCHMARK(Matrix3_MultiplyArray_Cold) { Matrix3MultiplyArray(state, ColdCount); }
+// the same products in the padded 3x4 layout
+static void PaddedMatrix3MultiplyArray(Bench::State& state, size_t count) {
+	std::vector<Matrix3> packed(count, SampleMatrix3());
+	MathClasses::PaddedMatrix3Array a(packed.data(), count), out;
+	MathClasses::PaddedMatrix3 b(SampleMatrix3());
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(MathClasses::PaddedMatrix3) * 2));
+	state.Run([&] {
+		a.Multiply(b, out);
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+BENCHMARK(PaddedMatrix3_Multiply) {
+	MathClasses::PaddedMatrix3 a(SampleMatrix3()), b(SampleMatrix3().Transposed());
+	state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); auto r = a * b; Bench::DoNotOptimize(r); });
+}
+
+BENCHMARK(PaddedMatrix3_MultiplyArray_Warm) { PaddedMatrix3MultiplyArray(state, WarmCount); }
+BENCHMARK(PaddedMatrix3_MultiplyArray_Cold) { PaddedMatrix3MultiplyArray(state, ColdCount); }
+BENCHMARK(Matrix3_InvertedArray_Warm) { Matrix3InvertArray(state, WarmCount, false); }
+BENCHMARK(Matrix3_InvertArray_Warm) { Matrix3InvertArray(state, WarmCount, true); }
+BENCHMARK(Matrix3_InvertedArray_Cold) { Matrix3InvertArray(state, ColdCount, false); }
+BENCHMARK(Matrix3_InvertArray_Cold) { Matrix3InvertArray(state, ColdCount, true); }
+
+// Euler angles to rotation matrices, one MakeEuler call each against the batch builder
+template <typename Matrix>
+static void MakeEulerArray(Bench::State& state, size_t count, bool batch) {
+	std::vector<Vector3> euler(count);
+	for (size_t i = 0; i < count; ++i) {
+		euler[i] = Vector3(0.001f * static_cast<float>(i % 6000) - 3.0f, 0.5f - 0.002f * static_cast<float>(i % 1000), 0.25f);
+	}
+	std::vector<Matrix> out(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (batch) {
+			Matrix::MakeEuler(euler.data(), out.data(), count);
+		} else {
+			for (size_t i = 0; i < count; ++i) {
+				out[i] = Matrix::MakeEuler(euler[i]);
+			}
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+BENCHMARK(Matrix3_MakeEulerEach_Warm) { MakeEulerArray<Matrix3>(state, WarmCount, false); }
+BENCHMARK(Matrix3_MakeEulerArray_Warm) { MakeEulerArray<Matrix3>(state, WarmCount, true); }
+BENCHMARK(Matrix4_MakeEulerEach_Warm) { MakeEulerArray<Matrix4>(state, WarmCount, false); }
+BENCHMARK(Matrix4_MakeEulerArray_Warm) { MakeEulerArray<Matrix4>(state, WarmCount, true); }
+BENCHMARK(Matrix3_MakeEulerEach_Cold) { MakeEulerArray<Matrix3>(state, ColdCount, false); }
+BENCHMARK(Matrix3_MakeEulerArray_Cold) { MakeEulerArray<Matrix3>(state, ColdCount, true); }
+BENCHMARK(Matrix4_MakeEulerEach_Cold) { MakeEulerArray<Matrix4>(state, ColdCount, false); }
+BENCHMARK(Matrix4_MakeEulerArray_Cold) { MakeEulerArray<Matrix4>(state, ColdCount, true); }
+
+// transforming points stored as Vector4 structs versus separate x/y/z/w arrays
+static void TransformAoS(Bench::State& state, size_t count) {
+	std::vector<Vector4> points(count, Vector4(1.0f, 2.0f, 3.0f, 1.0f)), out(count);
+	Matrix4 m = SampleMatrix4();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = m * points[i];
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+static void TransformSoA(Bench::State& state, size_t count) {
+	std::vector<float> x(count, 1.0f), y(count, 2.0f), z(count, 3.0f), w(count, 1.0f);
+	std::vector<float> ox(count), oy(count), oz(count), ow(count);
+	Matrix4 m = SampleMatrix4();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		for (size_t i = 0; i < count; ++i) {
+			ox[i] = x[i] * m.m1 + y[i] * m.m5 + z[i] * m.m9 + w[i] * m.m13;
+			oy[i] = x[i] * m.m2 + y[i] * m.m6 + z[i] * m.m10 + w[i] * m.m14;
+			oz[i] = x[i] * m.m3 + y[i] * m.m7 + z[i] * m.m11 + w[i] * m.m15;
+			ow[i] = x[i] * m.m4 + y[i] * m.m8 + z[i] * m.m12 + w[i] * m.m16;
+		}
+		Bench::DoNotOptimize(ox[0]);
+	});
+}
+
+static void TransformPointsSoA(Bench::State& state, size_t count, int mode) {
+	std::vector<float> x(count, 1.0f), y(count, 2.0f), z(count, 3.0f);
+	std::vector<float> ox(count), oy(count), oz(count);
+	Matrix4 m = SampleMatrix4();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (mode == 0) {
+			m.TransformPoints(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), count);
+		} else if (mode == 1) {
+			m.TransformDirections(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), count);
+		} else {
+			m.TransformPointsProjective(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), count);
+		}
+		Bench::DoNotOptimize(ox[0]);
+	});
+}
+
+// 2D points through a Matrix3: the full Vector3 product per point, against the affine batches
+static void Transform2D(Bench::State& state, size_t count, int mode) {
+	std::vector<float> x(count, 1.0f), y(count, 2.0f), ox(count), oy(count);
+	std::vector<MathClasses::Vector2> points(count, MathClasses::Vector2(1.0f, 2.0f)), out(count);
+	Matrix3 m = Matrix3::MakeTranslation(4.0f, -3.0f) * Matrix3::MakeRotateZ(0.5f);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (mode == 0) {
+			for (size_t i = 0; i < count; ++i) {
+				Vector3 r = m * Vector3(points[i].x, points[i].y, 1.0f);
+				out[i] = MathClasses::Vector2(r.x, r.y);
+			}
+		} else if (mode == 1) {
+			m.TransformPoints2D(points.data(), out.data(), count);
+		} else {
+			m.TransformPoints2D(x.data(), y.data(), ox.data(), oy.data(), count);
+		}
+		Bench::DoNotOptimize(out[0]);
+		Bench::DoNotOptimize(ox[0]);
+	});
+}
+
+BENCHMARK(Matrix3_Transform2D_Vector3_Warm) { Transform2D(state, WarmCount * 4, 0); }
+BENCHMARK(Matrix3_Transform2D_AoS_Warm) { Transform2D(state, WarmCount * 4, 1); }
+BENCHMARK(Matrix3_Transform2D_SoA_Warm) { Transform2D(state, WarmCount * 4, 2); }
+BENCHMARK(Matrix3_Transform2D_Vector3_Cold) { Transform2D(state, ColdCount * 4, 0); }
+BENCHMARK(Matrix3_Transform2D_AoS_Cold) { Transform2D(state, ColdCount * 4, 1); }
+BENCHMARK(Matrix3_Transform2D_SoA_Cold) { Transform2D(state, ColdCount * 4, 2); }
+
+BENCHMARK(Matrix4_TransformArray_AoS_Warm) { TransformAoS(state, WarmCount * 4); }
+BENCHMARK(Matrix4_TransformArray_SoA_Warm) { TransformSoA(state, WarmCount * 4); }
+BENCHMARK(Matrix4_TransformArray_AoS_Cold) { TransformAoS(state, ColdCount * 4); }
+BENCHMARK(Matrix4_TransformArray_SoA_Cold) { TransformSoA(state, ColdCount * 4); }
+BENCHMARK(Matrix4_TransformPoints_SoA_Warm) { TransformPointsSoA(state, WarmCount * 4, 0); }
+BENCHMARK(Matrix4_TransformDirections_SoA_Warm) { TransformPointsSoA(state, WarmCount * 4, 1); }
+BENCHMARK(Matrix4_TransformPointsProjective_SoA_Warm) { TransformPointsSoA(state, WarmCount * 4, 2); }
+BENCHMARK(Matrix4_TransformPoints_SoA_Cold) { TransformPointsSoA(state, ColdCount * 4, 0); }
+
+// the same product through views over external buffers, column-major and padded row-major
+BENCHMARK(Matrix4View_Multiply) {
+	float a[16], b[16];
+	MathClasses::Store(SampleMatrix4(), a);
+	MathClasses::Store(SampleMatrix4(), b);
+	state.Run([&] {
+		Bench::DoNotOptimize(a);
+		auto r = MathClasses::Matrix4View(a) * MathClasses::Matrix4View(b);
+		Bench::DoNotOptimize(r);
+	});
+}
+
+BENCHMARK(Matrix4View_MultiplyRowMajor) {
+	float a[20], b[16];
+	MathClasses::Store(SampleMatrix4(), a, MathClasses::MatrixOrder::RowMajor, 5);
+	MathClasses::Store(SampleMatrix4(), b);
+	state.Run([&] {
+		Bench::DoNotOptimize(a);
+		auto r = MathClasses::Matrix4View(a, MathClasses::MatrixOrder::RowMajor, 5) * MathClasses::Matrix4View(b);
+		Bench::DoNotOptimize(r);
+	});
+}
+
+// positions of an interleaved vertex buffer: copied out to Vector4, transformed and scattered
+// back, against transforming them in place
+namespace {
+	struct Vertex {
+		Vector3 position;
+		Vector3 normal;
+		float u, v;
+		unsigned colour;
+	};
+}
+
+static void TransformVerticesCopy(Bench::State& state, size_t count) {
+	std::vector<Vertex> vertices(count, Vertex{ Vector3(1.0f, 2.0f, 3.0f), Vector3(0.0f, 1.0f, 0.0f), 0.5f, 0.5f, 0u });
+	std::vector<Vector4> scratch(count);
+	Matrix4 m = Matrix4::MakeTranslation(0.0f, 0.0f, 0.0f);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		for (size_t i = 0; i < count; ++i) {
+			const Vector3& p = vertices[i].position;
+			scratch[i] = Vector4(p.x, p.y, p.z, 1.0f);
+		}
+		for (size_t i = 0; i < count; ++i) {
+			scratch[i] = m * scratch[i];
+		}
+		for (size_t i = 0; i < count; ++i) {
+			vertices[i].position = Vector3(scratch[i].x, scratch[i].y, scratch[i].z);
+		}
+		Bench::DoNotOptimize(vertices[0]);
+	});
+}
+
+static void TransformVerticesInPlace(Bench::State& state, size_t count) {
+	std::vector<Vertex> vertices(count, Vertex{ Vector3(1.0f, 2.0f, 3.0f), Vector3(0.0f, 1.0f, 0.0f), 0.5f, 0.5f, 0u });
+	Matrix4 m = Matrix4::MakeTranslation(0.0f, 0.0f, 0.0f);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		MathClasses::TransformPoints(m, vertices.data(), sizeof(Vertex), offsetof(Vertex, position), count);
+		Bench::DoNotOptimize(vertices[0]);
+	});
+}
+
+BENCHMARK(Vertices_TransformCopy_Warm) { TransformVerticesCopy(state, WarmCount * 4); }
+BENCHMARK(Vertices_TransformInPlace_Warm) { TransformVerticesInPlace(state, WarmCount * 4); }
+BENCHMARK(Vertices_TransformCopy_Cold) { TransformVerticesCopy(state, ColdCount); }
+BENCHMARK(Vertices_TransformInPlace_Cold) { TransformVerticesInPlace(state, ColdCount); }
+
+// sprite quads expanded one TransformPoint2D per corner against the batched stage
+static void Sprites(Bench::State& state, size_t count, bool batch) {
+	std::vector<Matrix3> transforms(count);
+	for (size_t i = 0; i < count; ++i) {
+		transforms[i] = Matrix3::MakeTranslation(0.5f * static_cast<float>(i), 2.0f) * Matrix3::MakeRotateZ(0.001f * static_cast<float>(i % 1000));
+	}
+	std::vector<MathClasses::Colour> tints(count, MathClasses::Colour(255, 128, 64, 255));
+	std::vector<MathClasses::SpriteVertex> out(count * 4);
+	MathClasses::Vector2 size(16.0f, 32.0f);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * (sizeof(Matrix3) + sizeof(MathClasses::Colour) + 4 * sizeof(MathClasses::SpriteVertex))));
+	state.Run([&] {
+		if (batch) {
+			MathClasses::BatchSprites(transforms.data(), tints.data(), count, size, out.data());
+		} else {
+			const MathClasses::Vector2 corners[4] = { { -8.0f, -16.0f }, { 8.0f, -16.0f }, { 8.0f, 16.0f }, { -8.0f, 16.0f } };
+			const float u[4] = { 0.0f, 1.0f, 1.0f, 0.0f }, v[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+			for (size_t i = 0; i < count; ++i) {
+				for (int c = 0; c < 4; ++c) {
+					MathClasses::Vector2 p = transforms[i].TransformPoint2D(corners[c]);
+					out[i * 4 + c] = { p.x, p.y, u[c], v[c], tints[i] };
+				}
+			}
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
+
+BENCHMARK(Sprites_PerCorner_Warm) { Sprites(state, WarmCount * 4, false); }
+BENCHMARK(Sprites_Batch_Warm) { Sprites(state, WarmCount * 4, true); }
+BENCHMARK(Sprites_PerCorner_Cold) { Sprites(state, ColdCount / 2, false); }
+BENCHMARK(Sprites_Batch_Cold) { Sprites(state, ColdCount / 2, true); }
+
+// every prefix product of a chain, the serial operator* fold against the blocked parallel scan
+template <typename Matrix>
+static void PrefixProducts(Bench::State& state, size_t count, bool scan) {
+	std::vector<Matrix> in(count), out(count);
+	for (size_t i = 0; i < count; ++i) {
+		in[i] = Matrix::MakeRotateZ(0.001f * static_cast<float>(i % 100));
+	}
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		if (scan) {
+			MathClasses::PrefixProducts(in.data(), out.data(), count);
+		} else {
+			out[0] = in[0];
+			for (size_t i = 1; i < count; ++i) {
+				out[i] = out[i - 1] * in[i];
+			}
+		}
+		Bench::DoNotOptimize(out[count - 1]);
+	});
+}
+
+BENCHMARK(Matrix4_PrefixFold_Warm) { PrefixProducts<Matrix4>(state, WarmCount, false); }
+BENCHMARK(Matrix4_PrefixScan_Warm) { PrefixProducts<Matrix4>(state, WarmCount, true); }
+BENCHMARK(Matrix4_PrefixFold_Cold) { PrefixProducts<Matrix4>(state, ColdCount / 2, false); }
+BENCHMARK(Matrix4_PrefixScan_Cold) { PrefixProducts<Matrix4>(state, ColdCount / 2, true); }
+BENCHMARK(Matrix3_PrefixFold_Cold) { PrefixProducts<Matrix3>(state, ColdCount / 2, false); }
+BENCHMARK(Matrix3_PrefixScan_Cold) { PrefixProducts<Matrix3>(state, ColdCount / 2, true); }
+
+// four-influence skinning of SoA positions and normals against a 64-bone palette
+static void Skin(Bench::State& state, size_t count, MathClasses::SkinningMode mode) {
+	std::vector<Matrix4> palette(64);
+	for (size_t b = 0; b < palette.size(); ++b) {
+		palette[b] = Matrix4::MakeEuler(0.01f * static_cast<float>(b), 0.2f, -0.1f) * Matrix4::MakeTranslation(0.1f * static_cast<float>(b), 1.0f, 0.0f);
+	}
+	std::vector<float> x(count, 1.0f), y(count, 2.0f), z(count, 3.0f), nx(count, 0.0f), ny(count, 1.0f), nz(count, 0.0f);
+	std::vector<float> ox(count), oy(count), oz(count), onx(count), ony(count), onz(count);
+	std::vector<uint16_t> bones(count * 4);
+	std::vector<float> weights(count * 4);
+	for (size_t i = 0; i < count; ++i) {
+		for (size_t j = 0; j < 4; ++j) {
+			bones[i * 4 + j] = static_cast<uint16_t>((i / 64 + j * 7) % palette.size());
+			weights[i * 4 + j] = j == 0 ? 0.4f : 0.2f;
+		}
+	}
+	MathClasses::SkinInput in;
+	in.x = x.data(); in.y = y.data(); in.z = z.data();
+	in.nx = nx.data(); in.ny = ny.data(); in.nz = nz.data();
+	in.bones = bones.data();
+	in.weights = weights.data();
+	MathClasses::SkinOutput out;
+	out.x = ox.data(); out.y = oy.data(); out.z = oz.data();
+	out.nx = onx.data(); out.ny = ony.data(); out.nz = onz.data();
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * (12 * sizeof(float) + 4 * sizeof(uint16_t) + 4 * sizeof(float))));
+	state.Run([&] {
+		MathClasses::Skin(in, palette.data(), palette.size(), out, count, mode);
+		Bench::DoNotOptimize(ox[0]);
+	});
+}
+
+BENCHMARK(Skin_Linear_Warm) { Skin(state, WarmCount * 4, MathClasses::SkinningMode::Linear); }
+BENCHMARK(Skin_DualQuaternion_Warm) { Skin(state, WarmCount * 4, MathClasses::SkinningMode::DualQuaternion); }
+BENCHMARK(Skin_Linear_Cold) { Skin(state, ColdCount / 2, MathClasses::SkinningMode::Linear); }
+BENCHMARK(Skin_DualQuaternion_Cold) { Skin(state, ColdCount / 2, MathClasses::SkinningMode::DualQuaternion); }
@@ -0,0 +1,177 @@
+#include "Benchmark.h"
+#include "MathHeaders/ColourSpace.h"
+#include "MathHeaders/Matrix4.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/TransformStore.h"
+#include "MathHeaders/Vector3.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using MathClasses::Colour;
+using MathClasses::Matrix4;
+using MathClasses::Vector3;
+namespace Parallel = MathClasses::Parallel;
+
+// Thread scaling of span kernels split by Parallel::For with its automatic grain. The grid runs
+// 1 to 64 threads over 1K to 100M elements, up to 2 GB of data, so it is registered as manual:
+//   MathBenchmarks --filter Scaling_              the whole grid
+//   MathBenchmarks --filter Scaling_Normalise_1M  one kernel and size across thread counts
+namespace {
+	const unsigned ThreadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+	const struct { size_t count; const char* label; } Sizes[] = {
+		{ 1000, "1K" }, { 10000, "10K" }, { 100000, "100K" },
+		{ 1000000, "1M" }, { 10000000, "10M" }, { 100000000, "100M" }
+	};
+
+	// sets the pool size for one benchmark call and restores the default after it
+	struct ScopedWorkers {
+		explicit ScopedWorkers(unsigned count) { Parallel::SetWorkerCount(count); }
+		~ScopedWorkers() { Parallel::SetWorkerCount(0); }
+	};
+
+	// SoA points transformed in place
+	void TransformPoints(Bench::State& state, size_t count, unsigned threads) {
+		std::vector<float> x(count, 1.0f), y(count, 2.0f), z(count, 3.0f);
+		Matrix4 m = Matrix4::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f);
+		ScopedWorkers workers(threads);
+		state.SetItemsPerIteration(static_cast<double>(count));
+		state.SetBytesPerIteration(static_cast<double>(count * 24));
+		state.Run([&] {
+			Parallel::For(count, 0, [&](size_t begin, size_t end) {
+				m.TransformPoints(x.data() + begin, y.data() + begin, z.data() + begin,
+					x.data() + begin, y.data() + begin, z.data() + begin, end - begin);
+			});
+			Bench::DoNotOptimize(x[0]);
+		});
+	}
+
+	// Vector3 array normalised in place
+	void Normalise(Bench::State& state, size_t count, unsigned threads) {
+		std::vector<Vector3> v(count, Vector3(1.0f, -2.0f, 0.5f));
+		ScopedWorkers workers(threads);
+		state.SetItemsPerIteration(static_cast<double>(count));
+		state.SetBytesPerIteration(static_cast<double>(count * sizeof(Vector3) * 2));
+		state.Run([&] {
+			Parallel::For(count, 0, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					v[i].Normalise();
+				}
+			});
+			Bench::DoNotOptimize(v[0]);
+		});
+	}
+
+	// packed colours converted to HSV
+	void ToHSV(Bench::State& state, size_t count, unsigned threads) {
+		std::vector<Colour> in(count);
+		for (size_t i = 0; i < count; ++i) {
+			in[i].colour = static_cast<uint32_t>(i * 2654435761u);
+		}
+		std::vector<MathClasses::ColourHSV> out(count);
+		ScopedWorkers workers(threads);
+		state.SetItemsPerIteration(static_cast<double>(count));
+		state.SetBytesPerIteration(static_cast<double>(count * (sizeof(Colour) + sizeof(MathClasses::ColourHSV))));
+		state.Run([&] {
+			Parallel::For(count, 0, [&](size_t begin, size_t end) {
+				MathClasses::ToHSV(in.data() + begin, out.data() + begin, end - begin);
+			});
+			Bench::DoNotOptimize(out[0]);
+		});
+	}
+
+	struct ScalingRegistrar {
+		ScalingRegistrar() {
+			const struct { const char* name; void (*fn)(Bench::State&, size_t, unsigned); } kernels[] = {
+				{ "TransformPoints", &TransformPoints }, { "Normalise", &Normalise }, { "ToHSV", &ToHSV }
+			};
+			for (const auto& kernel : kernels) {
+				for (const auto& size : Sizes) {
+					for (unsigned threads : ThreadCounts) {
+						char name[64];
+						std::snprintf(name, sizeof(name), "Scaling_%s_%s_T%02u", kernel.name, size.label, threads);
+						auto fn = kernel.fn;
+						size_t count = size.count;
+						Bench::Register(name, [fn, count, threads](Bench::State& state) { fn(state, count, threads); }, true);
+					}
+				}
+			}
+		}
+	} scalingRegistrar;
+}
+
+// A reader pulling world transforms while a simulation thread rewrites 1% of them per frame:
+// the mutex-guarded vector copies everything under the lock the writer also takes, the store
+// copies the changed blocks of its latest snapshot without waiting. Items are the transforms the
+// reader keeps up to date.
+namespace {
+	const size_t SharedTransforms = 10000;
+	const size_t TransformsPerFrame = SharedTransforms / 100;
+
+	// runs write(frame) on its own thread until destroyed
+	class WriterThread {
+	public:
+		template<class Fn>
+		explicit WriterThread(Fn write) : thread([this, write] {
+			for (size_t frame = 0; !stop.load(std::memory_order_relaxed); ++frame) {
+				write(frame);
+				std::this_thread::yield();
+			}
+		}) {}
+		~WriterThread() {
+			stop = true;
+			thread.join();
+		}
+
+	private:
+		std::atomic<bool> stop{ false };
+		std::thread thread;
+	};
+
+	// the frame's rewritten transforms, a contiguous run moving through the array
+	inline size_t FrameStart(size_t frame) {
+		return (frame * TransformsPerFrame * 7) % (SharedTransforms - TransformsPerFrame);
+	}
+}
+
+BENCHMARK(SharedTransforms_MutexCopy) {
+	std::vector<Matrix4> shared(SharedTransforms, Matrix4::MakeIdentity()), local(SharedTransforms);
+	std::mutex mutex;
+	WriterThread writer([&](size_t frame) {
+		std::lock_guard<std::mutex> lock(mutex);
+		size_t start = FrameStart(frame);
+		for (size_t i = start; i < start + TransformsPerFrame; ++i) {
+			shared[i] = Matrix4::MakeTranslation(float(frame), 0.0f, 0.0f);
+		}
+	});
+	state.SetItemsPerIteration(static_cast<double>(SharedTransforms));
+	state.Run([&] {
+		std::lock_guard<std::mutex> lock(mutex);
+		local = shared;
+		Bench::DoNotOptimize(local[0]);
+	});
+}
+
+BENCHMARK(SharedTransforms_StoreCopyChanged) {
+	MathClasses::TransformStore store(SharedTransforms);
+	std::vector<Matrix4> local(SharedTransforms);
+	uint64_t seen = 0;
+	WriterThread writer([&](size_t frame) {
+		size_t start = FrameStart(frame);
+		Matrix4* data = store.BeginFrame();
+		for (size_t i = start; i < start + TransformsPerFrame; ++i) {
+			data[i] = Matrix4::MakeTranslation(float(frame), 0.0f, 0.0f);
+		}
+		store.MarkDirty(start, start + TransformsPerFrame);
+		store.Publish();
+	});
+	state.SetItemsPerIteration(static_cast<double>(SharedTransforms));
+	state.Run([&] {
+		MathClasses::TransformStore::Snapshot snapshot = store.Acquire();
+		snapshot.CopyChanged(seen, local.data());
+		seen = snapshot.Frame();
+		Bench::DoNotOptimize(local[0]);
+	});
+}
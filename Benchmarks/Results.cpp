@@ -0,0 +1,123 @@
+#include "Results.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Bench {
+	void Summarise(Result& result) {
+		std::vector<double> sorted = result.samples;
+		std::sort(sorted.begin(), sorted.end());
+		size_t n = sorted.size();
+		if (n == 0) {
+			return;
+		}
+
+		result.median = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) * 0.5;
+
+		// distribution-free interval from order statistics: ranks n/2 -+ 1.96 * sqrt(n) / 2
+		double spread = 1.96 * std::sqrt(static_cast<double>(n)) * 0.5;
+		long lo = static_cast<long>(std::floor(n * 0.5 - spread));
+		long hi = static_cast<long>(std::ceil(n * 0.5 + spread));
+		lo = std::max(0L, std::min(lo, static_cast<long>(n) - 1));
+		hi = std::max(0L, std::min(hi, static_cast<long>(n) - 1));
+		result.ciLow = sorted[static_cast<size_t>(lo)];
+		result.ciHigh = sorted[static_cast<size_t>(hi)];
+	}
+
+	bool WriteJson(const std::string& path, const std::vector<Result>& results) {
+		std::ofstream out(path);
+		if (!out) {
+			return false;
+		}
+
+		out.precision(6);
+		out << std::fixed;
+		out << "{\n  \"benchmarks\": [\n";
+		for (size_t i = 0; i < results.size(); ++i) {
+			const Result& r = results[i];
+			out << "    {\n";
+			out << "      \"name\": \"" << r.name << "\",\n";
+			out << "      \"iterations\": " << r.iterations << ",\n";
+			out << "      \"median_ns\": " << r.median << ",\n";
+			out << "      \"ci_low_ns\": " << r.ciLow << ",\n";
+			out << "      \"ci_high_ns\": " << r.ciHigh << ",\n";
+			out << "      \"samples_ns\": [";
+			for (size_t s = 0; s < r.samples.size(); ++s) {
+				out << (s ? ", " : "") << r.samples[s];
+			}
+			out << "]\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+		}
+		out << "  ]\n}\n";
+		return static_cast<bool>(out);
+	}
+
+	bool ReadBaseline(const std::string& path, std::map<std::string, double>& medians) {
+		std::ifstream in(path);
+		if (!in) {
+			return false;
+		}
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		std::string text = buffer.str();
+
+		// only the fields WriteJson produces are understood: each "name" is followed by its "median_ns"
+		size_t pos = 0;
+		for (;;) {
+			size_t key = text.find("\"name\"", pos);
+			if (key == std::string::npos) {
+				break;
+			}
+			size_t open = text.find('"', text.find(':', key) + 1);
+			size_t close = text.find('"', open + 1);
+			size_t median = text.find("\"median_ns\"", close);
+			if (open == std::string::npos || close == std::string::npos || median == std::string::npos) {
+				return false;
+			}
+			std::string name = text.substr(open + 1, close - open - 1);
+			medians[name] = std::strtod(text.c_str() + text.find(':', median) + 1, nullptr);
+			pos = median;
+		}
+		return !medians.empty();
+	}
+
+	int CompareToBaseline(const std::vector<Result>& results, const std::map<std::string, double>& baseline, double threshold) {
+		int regressions = 0;
+		std::printf("\n%-44s %14s %14s %27s %9s  %s\n", "Benchmark", "base ns/op", "now ns/op", "95% CI", "change", "status");
+		for (const Result& r : results) {
+			auto found = baseline.find(r.name);
+			if (found == baseline.end()) {
+				std::printf("%-44s %14s %14.3f %12.3f..%-13.3f %9s  new\n", r.name.c_str(), "-", r.median, r.ciLow, r.ciHigh, "");
+				continue;
+			}
+
+			double base = found->second;
+			double change = base > 0 ? (r.median - base) / base : 0.0;
+			const char* status = "ok";
+			// only fail when even the fast end of the interval is past the threshold
+			if (r.ciLow > base * (1.0 + threshold)) {
+				status = "REGRESSED";
+				++regressions;
+			}
+			else if (r.ciHigh < base * (1.0 - threshold)) {
+				status = "faster";
+			}
+			std::printf("%-44s %14.3f %14.3f %12.3f..%-13.3f %+8.1f%%  %s\n",
+				r.name.c_str(), base, r.median, r.ciLow, r.ciHigh, change * 100.0, status);
+		}
+
+		for (const auto& entry : baseline) {
+			bool present = std::any_of(results.begin(), results.end(), [&](const Result& r) { return r.name == entry.first; });
+			if (!present) {
+				std::printf("%-44s %14.3f %14s %27s %9s  missing\n", entry.first.c_str(), entry.second, "-", "", "");
+			}
+		}
+
+		if (regressions > 0) {
+			std::printf("\n%d benchmark(s) regressed by more than %.0f%%\n", regressions, threshold * 100.0);
+		}
+		return regressions;
+	}
+}
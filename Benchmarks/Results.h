@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    // Timings of one benchmark over several repetitions
+    struct Result
+    {
+        std::string name;
+        size_t iterations = 0;
+        std::vector<double> samples;   // ns/op of each repetition
+        double median = 0;
+        double ciLow = 0;              // 95% confidence interval of the median
+        double ciHigh = 0;
+    };
+
+    // Fill in median and confidence interval from samples
+    void Summarise(Result& result);
+
+    // Write results as JSON, returns false if the file could not be written
+    bool WriteJson(const std::string& path, const std::vector<Result>& results);
+
+    // Read benchmark name -> median ns/op from a file written by WriteJson
+    bool ReadBaseline(const std::string& path, std::map<std::string, double>& medians);
+
+    // Print a comparison table and return the number of benchmarks whose whole
+    // confidence interval sits more than threshold (0.1 = 10%) above the baseline
+    int CompareToBaseline(const std::vector<Result>& results, const std::map<std::string, double>& baseline, double threshold);
+}
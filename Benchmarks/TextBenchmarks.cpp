@@ -0,0 +1,66 @@
+#include "Benchmark.h"
+#include "MathHeaders/Parse.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using MathClasses::Colour;
+using MathClasses::Matrix4;
+using MathClasses::Vector3;
+namespace Parse = MathClasses::Parse;
+
+namespace {
+	const size_t TextCount = 1 << 14;
+
+	// one value per line, as a log of ToString output would look
+	template <typename T, typename Make>
+	std::string MakeText(Make make) {
+		std::string text;
+		for (size_t i = 0; i < TextCount; ++i) {
+			text += make(i).ToString();
+			text += '\n';
+		}
+		return text;
+	}
+
+	template <typename T, typename Make>
+	void ParseMany(Bench::State& state, Make make) {
+		std::string text = MakeText<T>(make);
+		std::vector<T> out(TextCount);
+		state.SetItemsPerIteration(static_cast<double>(TextCount));
+		state.SetBytesPerIteration(static_cast<double>(text.size()));
+		state.Run([&] {
+			size_t count = Parse::Many(text.data(), text.data() + text.size(), out.data(), out.size());
+			Bench::DoNotOptimize(count);
+			Bench::DoNotOptimize(out[0]);
+		});
+	}
+
+	Vector3 SampleVector3(size_t i) {
+		return Vector3(0.25f * i, -1.5f + i % 17, 1000.0f / (1 + i % 13));
+	}
+}
+
+BENCHMARK(Parse_Vector3s) { ParseMany<Vector3>(state, SampleVector3); }
+BENCHMARK(Parse_Matrix4s) {
+	ParseMany<Matrix4>(state, [](size_t i) { return Matrix4::MakeEuler(0.001f * i, 0.5f, -0.25f) * Matrix4::MakeTranslation(SampleVector3(i)); });
+}
+BENCHMARK(Parse_Colours) {
+	ParseMany<Colour>(state, [](size_t i) { return Colour(uint8_t(i), uint8_t(i * 7), uint8_t(i * 13), 255); });
+}
+
+// what reading the same text with iostream costs
+BENCHMARK(Parse_Vector3s_Stream) {
+	std::string text = MakeText<Vector3>(SampleVector3);
+	std::vector<Vector3> out(TextCount);
+	state.SetItemsPerIteration(static_cast<double>(TextCount));
+	state.SetBytesPerIteration(static_cast<double>(text.size()));
+	state.Run([&] {
+		std::istringstream in(text);
+		char c;
+		for (Vector3& v : out) {
+			in >> c >> v.x >> c >> v.y >> c >> v.z >> c;
+		}
+		Bench::DoNotOptimize(out[0]);
+	});
+}
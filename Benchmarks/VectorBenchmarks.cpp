@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+#include "MathHeaders/Vector3.h"
+#include "MathHeaders/Vector4.h"
+#include <vector>
+
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+
+namespace {
+	// fits comfortably in L1, and well past the last level cache
+	const size_t WarmCount = 1 << 10;
+	const size_t ColdCount = 1 << 23;
+
+	// FormatTo target, global so the writes cannot be dropped
+	char formatBuffer[256];
+
+	std::vector<Vector3> MakeVector3s(size_t count) {
+		std::vector<Vector3> v(count);
+		for (size_t i = 0; i < count; ++i) {
+			v[i] = Vector3(1.0f + i % 7, 2.0f - i % 5, 0.5f + i % 3);
+		}
+		return v;
+	}
+
+	std::vector<Vector4> MakeVector4s(size_t count) {
+		std::vector<Vector4> v(count);
+		for (size_t i = 0; i < count; ++i) {
+			v[i] = Vector4(1.0f + i % 7, 2.0f - i % 5, 0.5f + i % 3, 0.0f);
+		}
+		return v;
+	}
+}
+
+// a binary operator or method evaluated once per iteration, inputs reloaded every time
+#define VECTOR3_BINARY(name, expr) \
+	BENCHMARK(name) { \
+		Vector3 a(1.5f, -2.0f, 3.25f), b(0.5f, 4.0f, -1.0f); \
+		state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); auto r = expr; Bench::DoNotOptimize(r); }); \
+	}
+
+#define VECTOR4_BINARY(name, expr) \
+	BENCHMARK(name) { \
+		Vector4 a(1.5f, -2.0f, 3.25f, 0.0f), b(0.5f, 4.0f, -1.0f, 0.0f); \
+		state.Run([&] { Bench::DoNotOptimize(a); Bench::DoNotOptimize(b); auto r = expr; Bench::DoNotOptimize(r); }); \
+	}
+
+// an in-place operation applied once per iteration
+#define VECTOR_INPLACE(name, Type, init, stmt) \
+	BENCHMARK(name) { \
+		Type a init, b init; \
+		float s = 1.0f; \
+		state.Run([&] { Bench::DoNotOptimize(b); Bench::DoNotOptimize(s); stmt; Bench::DoNotOptimize(a); }); \
+	}
+
+BENCHMARK(Vector3_Construct) {
+	float x = 1, y = 2, z = 3;
+	state.Run([&] { Bench::DoNotOptimize(x); Vector3 v(x, y, z); Bench::DoNotOptimize(v); });
+}
+VECTOR3_BINARY(Vector3_Add, a + b)
+VECTOR3_BINARY(Vector3_Subtract, a - b)
+VECTOR3_BINARY(Vector3_MultiplyScalar, a * b.x)
+VECTOR3_BINARY(Vector3_ScalarMultiply, b.x * a)
+VECTOR3_BINARY(Vector3_DivideScalar, a / b.y)
+VECTOR3_BINARY(Vector3_Magnitude, a.Magnitude())
+VECTOR3_BINARY(Vector3_MagnitudeSqr, a.MagnitudeSqr())
+VECTOR3_BINARY(Vector3_Normalised, a.Normalised())
+VECTOR3_BINARY(Vector3_Distance, a.Distance(b))
+VECTOR3_BINARY(Vector3_Dot, a.Dot(b))
+VECTOR3_BINARY(Vector3_Cross, a.Cross(b))
+VECTOR3_BINARY(Vector3_Equal, a == b)
+VECTOR3_BINARY(Vector3_NotEqual, a != b)
+VECTOR3_BINARY(Vector3_ToString, a.ToString())
+VECTOR3_BINARY(Vector3_FormatTo, a.FormatTo(formatBuffer, sizeof(formatBuffer)))
+VECTOR_INPLACE(Vector3_AddAssign, Vector3, (0.5f, 1.0f, 2.0f), a += b)
+VECTOR_INPLACE(Vector3_SubtractAssign, Vector3, (0.5f, 1.0f, 2.0f), a -= b)
+VECTOR_INPLACE(Vector3_MultiplyAssign, Vector3, (0.5f, 1.0f, 2.0f), a *= s)
+VECTOR_INPLACE(Vector3_DivideAssign, Vector3, (0.5f, 1.0f, 2.0f), a /= s)
+VECTOR_INPLACE(Vector3_Normalise, Vector3, (0.5f, 1.0f, 2.0f), a.Normalise())
+
+BENCHMARK(Vector4_Construct) {
+	float x = 1, y = 2, z = 3, w = 0;
+	state.Run([&] { Bench::DoNotOptimize(x); Vector4 v(x, y, z, w); Bench::DoNotOptimize(v); });
+}
+VECTOR4_BINARY(Vector4_Add, a + b)
+VECTOR4_BINARY(Vector4_Subtract, a - b)
+VECTOR4_BINARY(Vector4_MultiplyScalar, a * b.x)
+VECTOR4_BINARY(Vector4_ScalarMultiply, b.x * a)
+VECTOR4_BINARY(Vector4_DivideScalar, a / b.y)
+VECTOR4_BINARY(Vector4_Magnitude, a.Magnitude())
+VECTOR4_BINARY(Vector4_MagnitudeSqr, a.MagnitudeSqr())
+VECTOR4_BINARY(Vector4_Normalised, a.Normalised())
+VECTOR4_BINARY(Vector4_Distance, a.Distance(b))
+VECTOR4_BINARY(Vector4_Dot, a.Dot(b))
+VECTOR4_BINARY(Vector4_Cross, a.Cross(b))
+VECTOR4_BINARY(Vector4_Equal, a == b)
+VECTOR4_BINARY(Vector4_NotEqual, a != b)
+VECTOR4_BINARY(Vector4_ToString, a.ToString())
+VECTOR4_BINARY(Vector4_FormatTo, a.FormatTo(formatBuffer, sizeof(formatBuffer)))
+VECTOR_INPLACE(Vector4_AddAssign, Vector4, (0.5f, 1.0f, 2.0f, 0.0f), a += b)
+VECTOR_INPLACE(Vector4_SubtractAssign, Vector4, (0.5f, 1.0f, 2.0f, 0.0f), a -= b)
+VECTOR_INPLACE(Vector4_MultiplyAssign, Vector4, (0.5f, 1.0f, 2.0f, 0.0f), a *= s)
+VECTOR_INPLACE(Vector4_DivideAssign, Vector4, (0.5f, 1.0f, 2.0f, 0.0f), a /= s)
+VECTOR_INPLACE(Vector4_Normalise, Vector4, (0.5f, 1.0f, 2.0f, 0.0f), a.Normalise())
+
+// whole-array loops, warm (in cache) and cold (streamed from memory)
+static void NormaliseArray(Bench::State& state, size_t count) {
+	std::vector<Vector3> v = MakeVector3s(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Vector3) * 2));
+	state.Run([&] {
+		for (Vector3& x : v) {
+			x.Normalise();
+		}
+		Bench::DoNotOptimize(v[0]);
+	});
+}
+
+BENCHMARK(Vector3_NormaliseArray_Warm) { NormaliseArray(state, WarmCount); }
+BENCHMARK(Vector3_NormaliseArray_Cold) { NormaliseArray(state, ColdCount); }
+
+static void Vector4NormaliseArray(Bench::State& state, size_t count) {
+	std::vector<Vector4> v = MakeVector4s(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.SetBytesPerIteration(static_cast<double>(count * sizeof(Vector4) * 2));
+	state.Run([&] {
+		for (Vector4& x : v) {
+			x.Normalise();
+		}
+		Bench::DoNotOptimize(v[0]);
+	});
+}
+
+BENCHMARK(Vector4_NormaliseArray_Warm) { Vector4NormaliseArray(state, WarmCount); }
+BENCHMARK(Vector4_NormaliseArray_Cold) { Vector4NormaliseArray(state, ColdCount); }
+
+// the same dot product sum over array-of-structs and struct-of-arrays layouts
+static void DotAoS(Bench::State& state, size_t count) {
+	std::vector<Vector3> a = MakeVector3s(count), b = MakeVector3s(count);
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		float sum = 0;
+		for (size_t i = 0; i < count; ++i) {
+			sum += a[i].Dot(b[i]);
+		}
+		Bench::DoNotOptimize(sum);
+	});
+}
+
+static void DotSoA(Bench::State& state, size_t count) {
+	std::vector<float> ax(count), ay(count), az(count), bx(count), by(count), bz(count);
+	std::vector<Vector3> src = MakeVector3s(count);
+	for (size_t i = 0; i < count; ++i) {
+		ax[i] = bx[i] = src[i].x;
+		ay[i] = by[i] = src[i].y;
+		az[i] = bz[i] = src[i].z;
+	}
+	state.SetItemsPerIteration(static_cast<double>(count));
+	state.Run([&] {
+		float sum = 0;
+		for (size_t i = 0; i < count; ++i) {
+			sum += ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+		}
+		Bench::DoNotOptimize(sum);
+	});
+}
+
+BENCHMARK(Vector3_DotArray_AoS_Warm) { DotAoS(state, WarmCount); }
+BENCHMARK(Vector3_DotArray_SoA_Warm) { DotSoA(state, WarmCount); }
+BENCHMARK(Vector3_DotArray_AoS_Cold) { DotAoS(state, ColdCount); }
+BENCHMARK(Vector3_DotArray_SoA_Cold) { DotSoA(state, ColdCount); }
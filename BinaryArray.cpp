@@ -0,0 +1,499 @@
+#include "MathHeaders/BinaryArray.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MathClasses {
+	namespace {
+		const uint64_t Prime1 = 11400714785074694791ull;
+		const uint64_t Prime2 = 14029467366897019727ull;
+		const uint64_t Prime3 = 1609587929392839161ull;
+		const uint64_t Prime4 = 9650029242287828579ull;
+		const uint64_t Prime5 = 2870177450012600261ull;
+
+		inline uint64_t Rotl(uint64_t x, int r) {
+			return (x << r) | (x >> (64 - r));
+		}
+
+		inline uint64_t Read64(const uint8_t* p) {
+			uint64_t v;
+			std::memcpy(&v, p, 8);
+			return v;
+		}
+
+		inline uint64_t Round(uint64_t acc, uint64_t input) {
+			acc += input * Prime2;
+			return Rotl(acc, 31) * Prime1;
+		}
+
+		inline uint64_t Merge(uint64_t hash, uint64_t lane) {
+			hash ^= Round(0, lane);
+			return hash * Prime1 + Prime4;
+		}
+
+		bool LittleEndian() {
+			const uint16_t one = 1;
+			uint8_t first;
+			std::memcpy(&first, &one, 1);
+			return first == 1;
+		}
+
+		// expected element size for each element type, 0 if unknown
+		size_t ElementSize(uint32_t element) {
+			switch (static_cast<BinaryElement>(element)) {
+			case BinaryElement::Vector3: return sizeof(Vector3);
+			case BinaryElement::Vector4: return sizeof(Vector4);
+			case BinaryElement::Matrix3: return sizeof(Matrix3);
+			case BinaryElement::Matrix4: return sizeof(Matrix4);
+			case BinaryElement::Colour: return sizeof(Colour);
+			}
+			return 0;
+		}
+
+		inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		inline bool IsPowerOfTwo(uint64_t value) {
+			return value != 0 && (value & (value - 1)) == 0;
+		}
+
+		// bytes between SoA planes, each padded to the alignment
+		inline uint64_t PlaneStrideOf(uint64_t count, uint64_t alignment) {
+			return AlignUp(count * 4, alignment);
+		}
+
+		uint64_t PayloadSize(const BinaryHeader& h) {
+			if (h.layout == static_cast<uint32_t>(BinaryLayout::SoA)) {
+				return PlaneStrideOf(h.count, h.alignment) * (h.elementSize / 4);
+			}
+			return h.count * h.elementSize;
+		}
+
+		bool Seek(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+			return _fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+			return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+		}
+
+		bool WriteZeros(std::FILE* file, uint64_t count) {
+			static const uint8_t zeros[256] = {};
+			while (count > 0) {
+				size_t n = static_cast<size_t>(std::min<uint64_t>(count, sizeof(zeros)));
+				if (std::fwrite(zeros, 1, n, file) != n) {
+					return false;
+				}
+				count -= n;
+			}
+			return true;
+		}
+
+		uint64_t CombinePlanes(const std::vector<uint64_t>& planes) {
+			Checksum64 combined;
+			combined.Update(planes.data(), planes.size() * sizeof(uint64_t));
+			return combined.Final();
+		}
+	}
+
+	const char* BinaryStatusName(BinaryStatus status) {
+		switch (status) {
+		case BinaryStatus::Ok: return "ok";
+		case BinaryStatus::CannotOpen: return "cannot open file";
+		case BinaryStatus::IoError: return "I/O error";
+		case BinaryStatus::BadMagic: return "not a math array file";
+		case BinaryStatus::UnsupportedVersion: return "unsupported version";
+		case BinaryStatus::Truncated: return "truncated";
+		case BinaryStatus::BadHeader: return "invalid header";
+		case BinaryStatus::TypeMismatch: return "element type mismatch";
+		case BinaryStatus::ChecksumMismatch: return "checksum mismatch";
+		}
+		return "unknown";
+	}
+
+	Checksum64::Checksum64() : pendingSize(0), total(0) {
+		lanes[0] = Prime1 + Prime2;
+		lanes[1] = Prime2;
+		lanes[2] = 0;
+		lanes[3] = 0 - Prime1;
+	}
+
+	void Checksum64::Update(const void* data, size_t size) {
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		total += size;
+
+		if (pendingSize > 0) {
+			size_t take = std::min(size, sizeof(pending) - pendingSize);
+			std::memcpy(pending + pendingSize, p, take);
+			pendingSize += take;
+			p += take;
+			size -= take;
+			if (pendingSize < sizeof(pending)) {
+				return;
+			}
+			for (int i = 0; i < 4; ++i) {
+				lanes[i] = Round(lanes[i], Read64(pending + i * 8));
+			}
+			pendingSize = 0;
+		}
+
+		// the bulk, 32 bytes per step across four independent lanes
+		uint64_t v0 = lanes[0], v1 = lanes[1], v2 = lanes[2], v3 = lanes[3];
+		for (; size >= 32; p += 32, size -= 32) {
+			v0 = Round(v0, Read64(p));
+			v1 = Round(v1, Read64(p + 8));
+			v2 = Round(v2, Read64(p + 16));
+			v3 = Round(v3, Read64(p + 24));
+		}
+		lanes[0] = v0; lanes[1] = v1; lanes[2] = v2; lanes[3] = v3;
+
+		std::memcpy(pending, p, size);
+		pendingSize = size;
+	}
+
+	uint64_t Checksum64::Final() const {
+		uint64_t hash;
+		if (total >= 32) {
+			hash = Rotl(lanes[0], 1) + Rotl(lanes[1], 7) + Rotl(lanes[2], 12) + Rotl(lanes[3], 18);
+			for (int i = 0; i < 4; ++i) {
+				hash = Merge(hash, lanes[i]);
+			}
+		}
+		else {
+			hash = lanes[2] + Prime5;
+		}
+		hash += total;
+
+		const uint8_t* p = pending;
+		size_t size = pendingSize;
+		for (; size >= 8; p += 8, size -= 8) {
+			hash ^= Round(0, Read64(p));
+			hash = Rotl(hash, 27) * Prime1 + Prime4;
+		}
+		for (; size > 0; ++p, --size) {
+			hash ^= *p * Prime5;
+			hash = Rotl(hash, 11) * Prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	BinaryView::BinaryView() : base(nullptr), header() {}
+
+	BinaryStatus BinaryView::Open(const void* data, size_t size) {
+		base = nullptr;
+		if (!data || size < sizeof(BinaryHeader)) {
+			return BinaryStatus::Truncated;
+		}
+		BinaryHeader h;
+		std::memcpy(&h, data, sizeof(h));
+		if (h.magic != BinaryHeader::Magic || !LittleEndian()) {
+			return BinaryStatus::BadMagic;
+		}
+		if (h.version != BinaryHeader::CurrentVersion) {
+			return BinaryStatus::UnsupportedVersion;
+		}
+		size_t elementSize = ElementSize(h.element);
+		bool validLayout = h.layout == static_cast<uint32_t>(BinaryLayout::AoS) || h.layout == static_cast<uint32_t>(BinaryLayout::SoA);
+		if (h.headerSize < sizeof(BinaryHeader) || elementSize == 0 || h.elementSize != elementSize || !validLayout ||
+			!IsPowerOfTwo(h.alignment) || h.alignment < 4 || h.payloadOffset < h.headerSize || h.payloadOffset % h.alignment != 0) {
+			return BinaryStatus::BadHeader;
+		}
+		// reject counts whose payload size would overflow
+		if (h.count > (~uint64_t(0) / 2) / elementSize || h.payloadSize != PayloadSize(h)) {
+			return BinaryStatus::BadHeader;
+		}
+		if (h.payloadOffset > size || h.payloadSize > size - h.payloadOffset) {
+			return BinaryStatus::Truncated;
+		}
+		base = static_cast<const uint8_t*>(data);
+		header = h;
+		return BinaryStatus::Ok;
+	}
+
+	size_t BinaryView::PlaneStride() const {
+		return static_cast<size_t>(PlaneStrideOf(header.count, header.alignment));
+	}
+
+	BinaryStatus BinaryView::Verify() const {
+		if (!base) {
+			return BinaryStatus::BadHeader;
+		}
+		if ((header.flags & BinaryHeader::FlagChecksum) == 0) {
+			return BinaryStatus::Ok;
+		}
+		const uint8_t* payload = base + header.payloadOffset;
+		std::vector<uint64_t> planes;
+		if (header.layout == static_cast<uint32_t>(BinaryLayout::SoA)) {
+			for (size_t c = 0; c < header.elementSize / 4; ++c) {
+				Checksum64 plane;
+				plane.Update(payload + c * PlaneStride(), static_cast<size_t>(header.count) * 4);
+				planes.push_back(plane.Final());
+			}
+		}
+		else {
+			Checksum64 plane;
+			plane.Update(payload, static_cast<size_t>(header.payloadSize));
+			planes.push_back(plane.Final());
+		}
+		return CombinePlanes(planes) == header.checksum ? BinaryStatus::Ok : BinaryStatus::ChecksumMismatch;
+	}
+
+	const void* BinaryView::ElementsOf(BinaryElement element, size_t elementSize) const {
+		if (!base || header.element != static_cast<uint32_t>(element) || header.elementSize != elementSize ||
+			header.layout != static_cast<uint32_t>(BinaryLayout::AoS)) {
+			return nullptr;
+		}
+		// the payload offset is aligned, the mapping itself must be too
+		const uint8_t* payload = base + header.payloadOffset;
+		return reinterpret_cast<uintptr_t>(payload) % alignof(float) == 0 ? payload : nullptr;
+	}
+
+	const float* BinaryView::Plane(size_t component) const {
+		if (!base || header.layout != static_cast<uint32_t>(BinaryLayout::SoA) || component >= header.elementSize / 4) {
+			return nullptr;
+		}
+		const uint8_t* plane = base + header.payloadOffset + component * PlaneStride();
+		return reinterpret_cast<uintptr_t>(plane) % alignof(float) == 0 ? reinterpret_cast<const float*>(plane) : nullptr;
+	}
+
+	BinaryStatus BinaryView::CopyOut(BinaryElement element, size_t elementSize, void* out) const {
+		if (!base) {
+			return BinaryStatus::BadHeader;
+		}
+		if (header.element != static_cast<uint32_t>(element) || header.elementSize != elementSize) {
+			return BinaryStatus::TypeMismatch;
+		}
+		const uint8_t* payload = base + header.payloadOffset;
+		size_t count = static_cast<size_t>(header.count);
+		if (header.layout == static_cast<uint32_t>(BinaryLayout::AoS)) {
+			std::memcpy(out, payload, count * elementSize);
+			return BinaryStatus::Ok;
+		}
+		uint8_t* dst = static_cast<uint8_t*>(out);
+		for (size_t c = 0; c < elementSize / 4; ++c) {
+			const uint8_t* plane = payload + c * PlaneStride();
+			for (size_t i = 0; i < count; ++i) {
+				std::memcpy(dst + i * elementSize + c * 4, plane + i * 4, 4);
+			}
+		}
+		return BinaryStatus::Ok;
+	}
+
+	MappedFile::~MappedFile() {
+		Close();
+	}
+
+	BinaryStatus MappedFile::Open(const std::string& path) {
+		Close();
+#ifdef _WIN32
+		HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE) {
+			return BinaryStatus::CannotOpen;
+		}
+		file = handle;
+		LARGE_INTEGER length;
+		if (!GetFileSizeEx(handle, &length)) {
+			Close();
+			return BinaryStatus::IoError;
+		}
+		if (length.QuadPart == 0) {
+			return BinaryStatus::Ok;
+		}
+		mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			Close();
+			return BinaryStatus::IoError;
+		}
+		data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data) {
+			Close();
+			return BinaryStatus::IoError;
+		}
+		size = static_cast<size_t>(length.QuadPart);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return BinaryStatus::CannotOpen;
+		}
+		struct stat info;
+		if (fstat(fd, &info) != 0) {
+			::close(fd);
+			return BinaryStatus::IoError;
+		}
+		if (info.st_size > 0) {
+			void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			if (mapped == MAP_FAILED) {
+				::close(fd);
+				return BinaryStatus::IoError;
+			}
+			data = mapped;
+			size = static_cast<size_t>(info.st_size);
+		}
+		// the mapping keeps the file alive
+		::close(fd);
+#endif
+		return BinaryStatus::Ok;
+	}
+
+	void MappedFile::Close() {
+#ifdef _WIN32
+		if (data) {
+			UnmapViewOfFile(data);
+		}
+		if (mapping) {
+			CloseHandle(mapping);
+		}
+		if (file) {
+			CloseHandle(file);
+		}
+		mapping = nullptr;
+		file = nullptr;
+#else
+		if (data) {
+			munmap(const_cast<void*>(data), size);
+		}
+#endif
+		data = nullptr;
+		size = 0;
+	}
+
+	BinaryWriter::~BinaryWriter() {
+		Finish();
+	}
+
+	BinaryStatus BinaryWriter::Fail(BinaryStatus status) {
+		if (file) {
+			std::fclose(file);
+			file = nullptr;
+		}
+		return status;
+	}
+
+	BinaryStatus BinaryWriter::OpenRaw(const std::string& path, BinaryElement element, size_t elementSize, BinaryLayout layout,
+		size_t count, bool checksum, uint32_t alignment) {
+		Finish();
+		if (!IsPowerOfTwo(alignment) || alignment < 4 || (layout == BinaryLayout::SoA && count == UnknownCount) || !LittleEndian()) {
+			return BinaryStatus::BadHeader;
+		}
+		file = std::fopen(path.c_str(), "wb");
+		if (!file) {
+			return BinaryStatus::CannotOpen;
+		}
+
+		header = {};
+		header.version = BinaryHeader::CurrentVersion;
+		header.headerSize = sizeof(BinaryHeader);
+		header.element = static_cast<uint32_t>(element);
+		header.layout = static_cast<uint32_t>(layout);
+		header.elementSize = static_cast<uint32_t>(elementSize);
+		header.alignment = alignment;
+		header.flags = checksum ? BinaryHeader::FlagChecksum : 0;
+		header.count = count == UnknownCount ? 0 : count;
+		header.payloadOffset = AlignUp(sizeof(BinaryHeader), alignment);
+		written = 0;
+		planeHashes.assign(layout == BinaryLayout::SoA ? elementSize / 4 : 1, Checksum64());
+
+		// magic stays zero until Finish so an unfinished file is never taken as valid
+		if (std::fwrite(&header, sizeof(header), 1, file) != 1 || !WriteZeros(file, header.payloadOffset - sizeof(header))) {
+			return Fail(BinaryStatus::IoError);
+		}
+		return BinaryStatus::Ok;
+	}
+
+	BinaryStatus BinaryWriter::AppendRaw(const void* items, size_t count) {
+		if (!file) {
+			return BinaryStatus::IoError;
+		}
+		const uint8_t* src = static_cast<const uint8_t*>(items);
+		if (header.layout == static_cast<uint32_t>(BinaryLayout::AoS)) {
+			size_t bytes = count * header.elementSize;
+			if (std::fwrite(src, 1, bytes, file) != bytes) {
+				return Fail(BinaryStatus::IoError);
+			}
+			if (header.flags & BinaryHeader::FlagChecksum) {
+				planeHashes[0].Update(src, bytes);
+			}
+			written += count;
+			return BinaryStatus::Ok;
+		}
+
+		if (written + count > header.count) {
+			return BinaryStatus::BadHeader;
+		}
+		// gather each component into its plane a chunk at a time
+		const size_t chunk = 4096;
+		scratch.resize(chunk);
+		uint64_t stride = PlaneStrideOf(header.count, header.alignment);
+		for (size_t c = 0; c < header.elementSize / 4; ++c) {
+			if (!Seek(file, header.payloadOffset + c * stride + written * 4)) {
+				return Fail(BinaryStatus::IoError);
+			}
+			for (size_t begin = 0; begin < count; begin += chunk) {
+				size_t n = std::min(chunk, count - begin);
+				for (size_t i = 0; i < n; ++i) {
+					std::memcpy(&scratch[i], src + (begin + i) * header.elementSize + c * 4, 4);
+				}
+				if (std::fwrite(scratch.data(), 4, n, file) != n) {
+					return Fail(BinaryStatus::IoError);
+				}
+				if (header.flags & BinaryHeader::FlagChecksum) {
+					planeHashes[c].Update(scratch.data(), n * 4);
+				}
+			}
+		}
+		written += count;
+		return BinaryStatus::Ok;
+	}
+
+	BinaryStatus BinaryWriter::Finish() {
+		if (!file) {
+			return BinaryStatus::Ok;
+		}
+		if (header.layout == static_cast<uint32_t>(BinaryLayout::SoA)) {
+			if (written != header.count) {
+				return Fail(BinaryStatus::Truncated);
+			}
+		}
+		else {
+			header.count = written;
+		}
+		header.payloadSize = PayloadSize(header);
+
+		if (header.flags & BinaryHeader::FlagChecksum) {
+			std::vector<uint64_t> planes;
+			for (const Checksum64& plane : planeHashes) {
+				planes.push_back(plane.Final());
+			}
+			header.checksum = CombinePlanes(planes);
+		}
+		header.magic = BinaryHeader::Magic;
+
+		// pad the last SoA plane out so the payload size on disk matches the header
+		bool ok = true;
+		if (header.layout == static_cast<uint32_t>(BinaryLayout::SoA)) {
+			uint64_t lastPlaneEnd = header.payloadOffset + (header.elementSize / 4 - 1) * PlaneStrideOf(header.count, header.alignment) + header.count * 4;
+			ok = Seek(file, lastPlaneEnd) && WriteZeros(file, header.payloadOffset + header.payloadSize - lastPlaneEnd);
+		}
+		ok = ok && Seek(file, 0) && std::fwrite(&header, sizeof(header), 1, file) == 1;
+		ok = std::fclose(file) == 0 && ok;
+		file = nullptr;
+		return ok ? BinaryStatus::Ok : BinaryStatus::IoError;
+	}
+}
@@ -0,0 +1,173 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "MathHeaders/BinaryArray.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	namespace
+	{
+		std::vector<char> ReadFile(const char* path)
+		{
+			std::ifstream in(path, std::ios::binary);
+			return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+	}
+
+	TEST_CLASS(BinaryArrayTests)
+	{
+	public:
+		// AoS payload is used in place straight from the mapping
+		TEST_METHOD(MatrixRoundTripMapped)
+		{
+			const char* path = "BinaryArrayTests_matrix.bin";
+			std::vector<Matrix4> matrices;
+			for (int i = 0; i < 100; ++i)
+			{
+				matrices.push_back(Matrix4::MakeEuler(0.01f * i, 0.5f, -0.2f) * Matrix4::MakeTranslation(1.f * i, 2.f, 3.f));
+			}
+			Assert::IsTrue(WriteBinary(path, matrices.data(), matrices.size()) == BinaryStatus::Ok);
+
+			{
+				MappedFile file;
+				Assert::IsTrue(file.Open(path) == BinaryStatus::Ok);
+				BinaryView view;
+				Assert::IsTrue(view.Open(file.Data(), file.Size()) == BinaryStatus::Ok);
+				Assert::IsTrue(view.Verify() == BinaryStatus::Ok);
+				Assert::AreEqual(matrices.size(), view.Count());
+				Assert::AreEqual(size_t(0), static_cast<size_t>(view.Header().payloadOffset % 64));
+
+				const Matrix4* stored = view.Elements<Matrix4>();
+				Assert::IsNotNull(stored);
+				for (size_t i = 0; i < matrices.size(); ++i)
+				{
+					Assert::AreEqual(matrices[i], stored[i]);
+				}
+				Assert::IsNull(view.Elements<Vector4>());
+				Assert::IsNull(view.Plane(0));
+			}
+			std::remove(path);
+		}
+
+		// SoA written in several appends, read back as planes and as elements
+		TEST_METHOD(VectorSoAStreaming)
+		{
+			const char* path = "BinaryArrayTests_soa.bin";
+			std::vector<Vector3> vectors;
+			for (int i = 0; i < 1001; ++i)
+			{
+				vectors.push_back(Vector3(1.f * i, -2.f * i, 0.5f * i));
+			}
+
+			BinaryWriter writer;
+			Assert::IsTrue(writer.Open<Vector3>(path, BinaryLayout::SoA, vectors.size()) == BinaryStatus::Ok);
+			Assert::IsTrue(writer.Append(vectors.data(), 500) == BinaryStatus::Ok);
+			Assert::IsTrue(writer.Append(vectors.data() + 500, 501) == BinaryStatus::Ok);
+			Assert::IsTrue(writer.Append(&Matrix3::identity, 1) == BinaryStatus::TypeMismatch);
+			Assert::IsTrue(writer.Finish() == BinaryStatus::Ok);
+
+			std::vector<char> bytes = ReadFile(path);
+			BinaryView view;
+			Assert::IsTrue(view.Open(bytes.data(), bytes.size()) == BinaryStatus::Ok);
+			Assert::IsTrue(view.Verify() == BinaryStatus::Ok);
+			Assert::IsTrue(view.Layout() == BinaryLayout::SoA);
+			Assert::IsNull(view.Elements<Vector3>());
+
+			const float* y = view.Plane(1);
+			Assert::IsNotNull(y);
+			Assert::AreEqual(-2000.f, y[1000]);
+			Assert::IsNull(view.Plane(3));
+
+			std::vector<Vector3> copy(view.Count());
+			Assert::IsTrue(view.CopyTo(copy.data()) == BinaryStatus::Ok);
+			Assert::AreEqual(vectors[777], copy[777]);
+			std::remove(path);
+		}
+
+		// AoS output does not need the count up front
+		TEST_METHOD(UnknownCount)
+		{
+			const char* path = "BinaryArrayTests_colour.bin";
+			Colour colours[3] = { Colour(1, 2, 3, 4), Colour(5, 6, 7, 8), Colour(9, 10, 11, 12) };
+			BinaryWriter writer;
+			Assert::IsTrue(writer.Open<Colour>(path, BinaryLayout::AoS, BinaryWriter::UnknownCount, false) == BinaryStatus::Ok);
+			for (int i = 0; i < 10; ++i)
+			{
+				writer.Append(colours, 3);
+			}
+			Assert::IsTrue(writer.Finish() == BinaryStatus::Ok);
+
+			std::vector<char> bytes = ReadFile(path);
+			BinaryView view;
+			Assert::IsTrue(view.Open(bytes.data(), bytes.size()) == BinaryStatus::Ok);
+			Assert::AreEqual(size_t(30), view.Count());
+			Assert::AreEqual(colours[2], view.Elements<Colour>()[29]);
+			std::remove(path);
+		}
+
+		TEST_METHOD(Corruption)
+		{
+			const char* path = "BinaryArrayTests_corrupt.bin";
+			Vector4 values[64];
+			for (int i = 0; i < 64; ++i)
+			{
+				values[i] = Vector4(1.f * i, 2.f, 3.f, 4.f);
+			}
+			Assert::IsTrue(WriteBinary(path, values, 64) == BinaryStatus::Ok);
+			std::vector<char> bytes = ReadFile(path);
+			std::remove(path);
+
+			BinaryView view;
+			std::vector<char> flipped = bytes;
+			flipped[flipped.size() - 5] ^= 1;
+			Assert::IsTrue(view.Open(flipped.data(), flipped.size()) == BinaryStatus::Ok);
+			Assert::IsTrue(view.Verify() == BinaryStatus::ChecksumMismatch);
+
+			Assert::IsTrue(view.Open(bytes.data(), bytes.size() - 1) == BinaryStatus::Truncated);
+			Assert::IsTrue(view.Open(bytes.data(), 10) == BinaryStatus::Truncated);
+
+			std::vector<char> badMagic = bytes;
+			badMagic[0] = 'X';
+			Assert::IsTrue(view.Open(badMagic.data(), badMagic.size()) == BinaryStatus::BadMagic);
+
+			Matrix3 out[64];
+			Assert::IsTrue(view.Open(bytes.data(), bytes.size()) == BinaryStatus::Ok);
+			Assert::IsTrue(view.CopyTo(out) == BinaryStatus::TypeMismatch);
+		}
+
+		// the hash does not depend on how the data is split across updates
+		TEST_METHOD(ChecksumStreaming)
+		{
+			std::vector<unsigned char> data(1000);
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				data[i] = static_cast<unsigned char>(i * 31 + 7);
+			}
+			Checksum64 whole;
+			whole.Update(data.data(), data.size());
+
+			Checksum64 pieces;
+			size_t splits[] = { 1, 7, 31, 33, 64, 100, 3 };
+			size_t offset = 0;
+			for (size_t n : splits)
+			{
+				pieces.Update(data.data() + offset, n);
+				offset += n;
+			}
+			pieces.Update(data.data() + offset, data.size() - offset);
+			Assert::IsTrue(whole.Final() == pieces.Final());
+
+			data[500] ^= 0x10;
+			Checksum64 changed;
+			changed.Update(data.data(), data.size());
+			Assert::IsTrue(whole.Final() != changed.Final());
+		}
+	};
+}
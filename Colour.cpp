@@ -1,4 +1,7 @@
 #include "MathHeaders/Colour.h"
+#include "MathHeaders/Format.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
 #include <cstdint>
 
 namespace MathClasses {
@@ -50,4 +53,189 @@ namespace MathClasses {
 	bool Colour::operator!=(const Colour& other) const {
 		return colour != other.colour;
 	}
+
+	std::string Colour::ToString() const {
+		char buffer[16];
+		return std::string(buffer, FormatTo(buffer, sizeof(buffer)));
+	}
+
+	size_t Colour::FormatTo(char* buffer, size_t size) const {
+		Format::Writer out(buffer, size);
+		out.Put('#');
+		out.PutHex(GetRed());
+		out.PutHex(GetGreen());
+		out.PutHex(GetBlue());
+		out.PutHex(GetAlpha());
+		return out.Finish();
+	}
+
+	namespace {
+		// apply op to each of the four channels of two packed colours
+		template <typename Op>
+		uint32_t PerChannel(uint32_t a, uint32_t b, Op op) {
+			uint32_t result = 0;
+			for (int shift = 0; shift < 32; shift += 8) {
+				int value = op(static_cast<int>((a >> shift) & 0xff), static_cast<int>((b >> shift) & 0xff));
+				result |= static_cast<uint32_t>(std::min(std::max(value, 0), 255)) << shift;
+			}
+			return result;
+		}
+
+		// t in [0, 1] as a weight out of 256; written so a NaN t clamps to 0 rather than reaching the cast
+		int LerpWeight(float t) {
+			t = t > 0.0f ? t : 0.0f;
+			t = t < 1.0f ? t : 1.0f;
+			return static_cast<int>(t * 256.0f + 0.5f);
+		}
+
+		uint32_t LerpPacked(uint32_t a, uint32_t b, int weight) {
+			return PerChannel(a, b, [weight](int x, int y) { return (x * (256 - weight) + y * weight + 128) >> 8; });
+		}
+
+#if MATHCLASSES_SSE2
+		// blend four colours with 16-bit per-channel weights out of 256 (lo = first two pixels)
+		__m128i Lerp4(__m128i a, __m128i b, __m128i weightLo, __m128i weightHi) {
+			__m128i zero = _mm_setzero_si128();
+			__m128i full = _mm_set1_epi16(256);
+			__m128i round = _mm_set1_epi16(128);
+			__m128i lo = _mm_add_epi16(
+				_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_sub_epi16(full, weightLo)),
+					_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weightLo)), round);
+			__m128i hi = _mm_add_epi16(
+				_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_sub_epi16(full, weightHi)),
+					_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weightHi)), round);
+			return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+		}
+
+		__m128i Load4(const Colour* c) {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(c));
+		}
+
+		void Store4(Colour* c, __m128i v) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(c), v);
+		}
+#endif
+	}
+
+	Colour Colour::operator+(const Colour& other) const {
+		Colour result;
+		result.colour = PerChannel(colour, other.colour, [](int x, int y) { return x + y; });
+		return result;
+	}
+
+	Colour& Colour::operator+=(const Colour& other) {
+		*this = *this + other;
+		return *this;
+	}
+
+	Colour Colour::operator-(const Colour& other) const {
+		Colour result;
+		result.colour = PerChannel(colour, other.colour, [](int x, int y) { return x - y; });
+		return result;
+	}
+
+	Colour& Colour::operator-=(const Colour& other) {
+		*this = *this - other;
+		return *this;
+	}
+
+	Colour Colour::operator*(float scalar) const {
+		Colour result;
+		result.colour = PerChannel(colour, 0, [scalar](int x, int) {
+			float value = x * scalar + 0.5f;
+			return value < 255.0f ? (value > 0.0f ? static_cast<int>(value) : 0) : 255;
+		});
+		return result;
+	}
+
+	Colour& Colour::operator*=(float scalar) {
+		*this = *this * scalar;
+		return *this;
+	}
+
+	Colour Colour::Lerp(const Colour& a, const Colour& b, float t) {
+		Colour result;
+		result.colour = LerpPacked(a.colour, b.colour, LerpWeight(t));
+		return result;
+	}
+
+	void AddSaturate(const Colour* a, const Colour* b, Colour* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			Store4(out + i, _mm_adds_epu8(Load4(a + i), Load4(b + i)));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = a[i] + b[i];
+		}
+	}
+
+	void SubtractSaturate(const Colour* a, const Colour* b, Colour* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			Store4(out + i, _mm_subs_epu8(Load4(a + i), Load4(b + i)));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = a[i] - b[i];
+		}
+	}
+
+	void Average(const Colour* a, const Colour* b, Colour* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			Store4(out + i, _mm_avg_epu8(Load4(a + i), Load4(b + i)));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i].colour = PerChannel(a[i].colour, b[i].colour, [](int x, int y) { return (x + y + 1) >> 1; });
+		}
+	}
+
+	void CrossFade(const Colour* a, const Colour* b, Colour* out, size_t count, float t) {
+		int weight = LerpWeight(t);
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		__m128i w = _mm_set1_epi16(static_cast<short>(weight));
+		for (; i + 4 <= count; i += 4) {
+			Store4(out + i, Lerp4(Load4(a + i), Load4(b + i), w, w));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i].colour = LerpPacked(a[i].colour, b[i].colour, weight);
+		}
+	}
+
+	void FillGradient(Colour* out, size_t count, const Colour& from, const Colour& to) {
+		if (count == 0) {
+			return;
+		}
+		if (count == 1) {
+			out[0] = from;
+			return;
+		}
+
+		// weight of entry i is i / (count - 1) out of 256, rounded
+		size_t last = count - 1;
+		auto weightAt = [last](size_t i) { return static_cast<int>((i * 256 + last / 2) / last); };
+
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		__m128i a = _mm_set1_epi32(static_cast<int>(from.colour));
+		__m128i b = _mm_set1_epi32(static_cast<int>(to.colour));
+		for (; i + 4 <= count; i += 4) {
+			short w0 = static_cast<short>(weightAt(i)), w1 = static_cast<short>(weightAt(i + 1));
+			short w2 = static_cast<short>(weightAt(i + 2)), w3 = static_cast<short>(weightAt(i + 3));
+			__m128i weightLo = _mm_set_epi16(w1, w1, w1, w1, w0, w0, w0, w0);
+			__m128i weightHi = _mm_set_epi16(w3, w3, w3, w3, w2, w2, w2, w2);
+			Store4(out + i, Lerp4(a, b, weightLo, weightHi));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i].colour = LerpPacked(from.colour, to.colour, weightAt(i));
+		}
+	}
 }
\ No newline at end of file
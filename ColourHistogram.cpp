@@ -0,0 +1,251 @@
+#include "MathHeaders/ColourHistogram.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
+#include <cstring>
+
+namespace MathClasses {
+	ColourHistogram::ColourHistogram() {
+		Clear();
+	}
+
+	void ColourHistogram::Clear() {
+		std::memset(red, 0, sizeof(red));
+		std::memset(green, 0, sizeof(green));
+		std::memset(blue, 0, sizeof(blue));
+		std::memset(alpha, 0, sizeof(alpha));
+	}
+
+	void ColourHistogram::Add(const Colour& c) {
+		// read straight from the packed value instead of going through the getters
+		uint32_t v = c.colour;
+		++red[v >> 24];
+		++green[(v >> 16) & 0xff];
+		++blue[(v >> 8) & 0xff];
+		++alpha[v & 0xff];
+	}
+
+	void ColourHistogram::Merge(const ColourHistogram& other) {
+		for (int i = 0; i < 256; ++i) {
+			red[i] += other.red[i];
+			green[i] += other.green[i];
+			blue[i] += other.blue[i];
+			alpha[i] += other.alpha[i];
+		}
+	}
+
+	uint64_t ColourHistogram::Total() const {
+		uint64_t total = 0;
+		for (int i = 0; i < 256; ++i) {
+			total += red[i];
+		}
+		return total;
+	}
+
+	ColourHistogram ColourHistogram::Build(const Colour* pixels, size_t count, unsigned threadCount) {
+		// below this size spawning threads costs more than counting
+		const size_t minPixelsPerThread = 1 << 16;
+
+		size_t chunks = threadCount > 0 ? threadCount : Parallel::WorkerCount();
+		chunks = std::max<size_t>(1, std::min(chunks, count / minPixelsPerThread));
+
+		std::vector<ColourHistogram> partial(chunks);
+		Parallel::ForChunks(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+			ColourHistogram& h = partial[chunk];
+			for (size_t i = begin; i < end; ++i) {
+				h.Add(pixels[i]);
+			}
+		});
+
+		ColourHistogram result = partial[0];
+		for (size_t i = 1; i < partial.size(); ++i) {
+			result.Merge(partial[i]);
+		}
+		return result;
+	}
+
+	namespace {
+		int Channel(uint32_t c, int channel) {
+			return static_cast<int>((c >> (24 - channel * 8)) & 0xff);
+		}
+
+		struct ColourBox {
+			size_t begin, end;
+			int widestChannel;
+			int range;
+		};
+
+		ColourBox MakeBox(const std::vector<uint32_t>& values, size_t begin, size_t end) {
+			int lo[4] = { 255, 255, 255, 255 };
+			int hi[4] = { 0, 0, 0, 0 };
+			for (size_t i = begin; i < end; ++i) {
+				for (int ch = 0; ch < 4; ++ch) {
+					int v = Channel(values[i], ch);
+					lo[ch] = std::min(lo[ch], v);
+					hi[ch] = std::max(hi[ch], v);
+				}
+			}
+
+			ColourBox box{ begin, end, 0, hi[0] - lo[0] };
+			for (int ch = 1; ch < 4; ++ch) {
+				if (hi[ch] - lo[ch] > box.range) {
+					box.widestChannel = ch;
+					box.range = hi[ch] - lo[ch];
+				}
+			}
+			return box;
+		}
+
+		Colour AverageBox(const std::vector<uint32_t>& values, const ColourBox& box) {
+			uint64_t sum[4] = { 0, 0, 0, 0 };
+			for (size_t i = box.begin; i < box.end; ++i) {
+				for (int ch = 0; ch < 4; ++ch) {
+					sum[ch] += Channel(values[i], ch);
+				}
+			}
+			uint64_t n = box.end - box.begin;
+			return Colour(
+				static_cast<uint8_t>((sum[0] + n / 2) / n),
+				static_cast<uint8_t>((sum[1] + n / 2) / n),
+				static_cast<uint8_t>((sum[2] + n / 2) / n),
+				static_cast<uint8_t>((sum[3] + n / 2) / n));
+		}
+	}
+
+	std::vector<Colour> MakePaletteMedianCut(const Colour* pixels, size_t count, size_t paletteSize) {
+		std::vector<Colour> palette;
+		if (count == 0 || paletteSize == 0) {
+			return palette;
+		}
+
+		std::vector<uint32_t> values(count);
+		for (size_t i = 0; i < count; ++i) {
+			values[i] = pixels[i].colour;
+		}
+
+		std::vector<ColourBox> boxes;
+		boxes.push_back(MakeBox(values, 0, count));
+
+		while (boxes.size() < paletteSize) {
+			// split the box with the widest channel range at its median
+			auto widest = std::max_element(boxes.begin(), boxes.end(),
+				[](const ColourBox& a, const ColourBox& b) { return a.range < b.range; });
+			if (widest->range == 0) {
+				break;
+			}
+
+			ColourBox box = *widest;
+			int ch = box.widestChannel;
+			size_t mid = box.begin + (box.end - box.begin) / 2;
+			std::nth_element(values.begin() + box.begin, values.begin() + mid, values.begin() + box.end,
+				[ch](uint32_t a, uint32_t b) { return Channel(a, ch) < Channel(b, ch); });
+
+			*widest = MakeBox(values, box.begin, mid);
+			boxes.push_back(MakeBox(values, mid, box.end));
+		}
+
+		palette.reserve(boxes.size());
+		for (const ColourBox& box : boxes) {
+			palette.push_back(AverageBox(values, box));
+		}
+		return palette;
+	}
+
+	size_t FindNearestPaletteIndex(const Colour& c, const Colour* palette, size_t paletteSize) {
+		size_t best = 0;
+		int bestDistance = 0x7fffffff;
+		for (size_t i = 0; i < paletteSize; ++i) {
+			int distance = 0;
+			for (int ch = 0; ch < 4; ++ch) {
+				int d = Channel(c.colour, ch) - Channel(palette[i].colour, ch);
+				distance += d * d;
+			}
+			if (distance < bestDistance) {
+				bestDistance = distance;
+				best = i;
+			}
+		}
+		return best;
+	}
+
+	void MapToPalette(const Colour* pixels, size_t count, const Colour* palette, size_t paletteSize, uint8_t* indices) {
+		if (paletteSize == 0) {
+			return;
+		}
+
+#if MATHCLASSES_SSE2
+		// palette is stored as 16-bit SoA lanes, eight entries per register. Padding entries
+		// sit far outside the 0..255 range so they can never be the nearest match
+		size_t padded = (paletteSize + 7) & ~static_cast<size_t>(7);
+		std::vector<int16_t> soa(padded * 4, 1000);
+		for (size_t i = 0; i < paletteSize; ++i) {
+			for (int ch = 0; ch < 4; ++ch) {
+				soa[ch * padded + i] = static_cast<int16_t>(Channel(palette[i].colour, ch));
+			}
+		}
+
+		Parallel::For(count, 4096, [&](size_t begin, size_t end) {
+			const __m128i* pr = reinterpret_cast<const __m128i*>(&soa[0]);
+			const __m128i* pg = reinterpret_cast<const __m128i*>(&soa[padded]);
+			const __m128i* pb = reinterpret_cast<const __m128i*>(&soa[padded * 2]);
+			const __m128i* pa = reinterpret_cast<const __m128i*>(&soa[padded * 3]);
+
+			for (size_t p = begin; p < end; ++p) {
+				uint32_t v = pixels[p].colour;
+				__m128i r = _mm_set1_epi16(static_cast<int16_t>(Channel(v, 0)));
+				__m128i g = _mm_set1_epi16(static_cast<int16_t>(Channel(v, 1)));
+				__m128i b = _mm_set1_epi16(static_cast<int16_t>(Channel(v, 2)));
+				__m128i a = _mm_set1_epi16(static_cast<int16_t>(Channel(v, 3)));
+
+				__m128i bestLo = _mm_set1_epi32(0x7fffffff), bestHi = bestLo;
+				__m128i indexLo = _mm_setzero_si128(), indexHi = indexLo;
+				__m128i laneLo = _mm_setr_epi32(0, 1, 2, 3), laneHi = _mm_setr_epi32(4, 5, 6, 7);
+				const __m128i eight = _mm_set1_epi32(8);
+
+				for (size_t i = 0; i < padded / 8; ++i) {
+					__m128i dr = _mm_sub_epi16(_mm_loadu_si128(pr + i), r);
+					__m128i dg = _mm_sub_epi16(_mm_loadu_si128(pg + i), g);
+					__m128i db = _mm_sub_epi16(_mm_loadu_si128(pb + i), b);
+					__m128i da = _mm_sub_epi16(_mm_loadu_si128(pa + i), a);
+
+					// interleaving (r, g) and (b, a) pairs lets madd square and add them in one step
+					__m128i rgLo = _mm_unpacklo_epi16(dr, dg), rgHi = _mm_unpackhi_epi16(dr, dg);
+					__m128i baLo = _mm_unpacklo_epi16(db, da), baHi = _mm_unpackhi_epi16(db, da);
+					__m128i distLo = _mm_add_epi32(_mm_madd_epi16(rgLo, rgLo), _mm_madd_epi16(baLo, baLo));
+					__m128i distHi = _mm_add_epi32(_mm_madd_epi16(rgHi, rgHi), _mm_madd_epi16(baHi, baHi));
+
+					__m128i closerLo = _mm_cmplt_epi32(distLo, bestLo);
+					__m128i closerHi = _mm_cmplt_epi32(distHi, bestHi);
+					bestLo = _mm_or_si128(_mm_and_si128(closerLo, distLo), _mm_andnot_si128(closerLo, bestLo));
+					bestHi = _mm_or_si128(_mm_and_si128(closerHi, distHi), _mm_andnot_si128(closerHi, bestHi));
+					indexLo = _mm_or_si128(_mm_and_si128(closerLo, laneLo), _mm_andnot_si128(closerLo, indexLo));
+					indexHi = _mm_or_si128(_mm_and_si128(closerHi, laneHi), _mm_andnot_si128(closerHi, indexHi));
+
+					laneLo = _mm_add_epi32(laneLo, eight);
+					laneHi = _mm_add_epi32(laneHi, eight);
+				}
+
+				alignas(16) int32_t dist[8], index[8];
+				_mm_store_si128(reinterpret_cast<__m128i*>(dist), bestLo);
+				_mm_store_si128(reinterpret_cast<__m128i*>(dist + 4), bestHi);
+				_mm_store_si128(reinterpret_cast<__m128i*>(index), indexLo);
+				_mm_store_si128(reinterpret_cast<__m128i*>(index + 4), indexHi);
+
+				int best = 0;
+				for (int lane = 1; lane < 8; ++lane) {
+					if (dist[lane] < dist[best] || (dist[lane] == dist[best] && index[lane] < index[best])) {
+						best = lane;
+					}
+				}
+				indices[p] = static_cast<uint8_t>(index[best]);
+			}
+		});
+#else
+		Parallel::For(count, 4096, [&](size_t begin, size_t end) {
+			for (size_t p = begin; p < end; ++p) {
+				indices[p] = static_cast<uint8_t>(FindNearestPaletteIndex(pixels[p], palette, paletteSize));
+			}
+		});
+#endif
+	}
+}
@@ -0,0 +1,90 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/ColourHistogram.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Colour;
+using ::MathClasses::ColourHistogram;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ColourHistogramTests)
+	{
+	public:
+		// counts land in the right bins
+		TEST_METHOD(AddColour)
+		{
+			ColourHistogram hist;
+			hist.Add(Colour(32, 64, 10, 255));
+			hist.Add(Colour(32, 0, 10, 128));
+
+			Assert::AreEqual((uint64_t)2, hist.red[32]);
+			Assert::AreEqual((uint64_t)1, hist.green[64]);
+			Assert::AreEqual((uint64_t)1, hist.green[0]);
+			Assert::AreEqual((uint64_t)2, hist.blue[10]);
+			Assert::AreEqual((uint64_t)1, hist.alpha[128]);
+			Assert::AreEqual((uint64_t)2, hist.Total());
+		}
+
+		// threaded build matches a single threaded build
+		TEST_METHOD(BuildMatchesSerial)
+		{
+			std::vector<Colour> pixels;
+			for (int i = 0; i < 300000; ++i)
+			{
+				pixels.push_back(Colour(i & 0xff, (i * 7) & 0xff, (i * 13) & 0xff, (i * 31) & 0xff));
+			}
+
+			ColourHistogram serial = ColourHistogram::Build(pixels.data(), pixels.size(), 1);
+			ColourHistogram threaded = ColourHistogram::Build(pixels.data(), pixels.size(), 4);
+
+			for (int i = 0; i < 256; ++i)
+			{
+				Assert::AreEqual(serial.red[i], threaded.red[i]);
+				Assert::AreEqual(serial.green[i], threaded.green[i]);
+				Assert::AreEqual(serial.blue[i], threaded.blue[i]);
+				Assert::AreEqual(serial.alpha[i], threaded.alpha[i]);
+			}
+			Assert::AreEqual((uint64_t)pixels.size(), threaded.Total());
+		}
+
+		// median cut keeps distinct colours when there are few of them
+		TEST_METHOD(MedianCutFewColours)
+		{
+			std::vector<Colour> pixels = {
+				Colour(255, 0, 0, 255), Colour(0, 255, 0, 255),
+				Colour(255, 0, 0, 255), Colour(0, 0, 255, 255) };
+
+			std::vector<Colour> palette = MathClasses::MakePaletteMedianCut(pixels.data(), pixels.size(), 256);
+
+			Assert::AreEqual((size_t)3, palette.size());
+			for (const Colour& c : pixels)
+			{
+				size_t index = MathClasses::FindNearestPaletteIndex(c, palette.data(), palette.size());
+				Assert::IsTrue(c == palette[index]);
+			}
+		}
+
+		// batched mapping agrees with the scalar search
+		TEST_METHOD(MapToPalette)
+		{
+			std::vector<Colour> pixels;
+			for (int i = 0; i < 5000; ++i)
+			{
+				pixels.push_back(Colour((i * 37) & 0xff, (i * 11) & 0xff, (i * 5) & 0xff, 255));
+			}
+
+			std::vector<Colour> palette = MathClasses::MakePaletteMedianCut(pixels.data(), pixels.size(), 19);
+			std::vector<uint8_t> indices(pixels.size());
+			MathClasses::MapToPalette(pixels.data(), pixels.size(), palette.data(), palette.size(), indices.data());
+
+			for (size_t i = 0; i < pixels.size(); ++i)
+			{
+				Assert::AreEqual(MathClasses::FindNearestPaletteIndex(pixels[i], palette.data(), palette.size()), (size_t)indices[i]);
+			}
+		}
+	};
+}
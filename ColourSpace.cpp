@@ -0,0 +1,233 @@
+#include "MathHeaders/ColourSpace.h"
+#include "MathHeaders/ColourSimd.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace MathClasses {
+	namespace {
+		using Simd::MaxPs;
+		using Simd::MinPs;
+		using Simd::ToByte;
+
+		const float Inv255 = 1.0f / 255.0f;
+
+		// hue in degrees plus the max/min channel values shared by HSV and HSL
+		float Hue(float r, float g, float b, float mx, float d) {
+			if (d <= 0.0f) {
+				return 0.0f;
+			}
+			float h;
+			if (mx == r) {
+				h = (g - b) / d;
+				if (h < 0.0f) {
+					h += 6.0f;
+				}
+			}
+			else if (mx == g) {
+				h = (b - r) / d + 2.0f;
+			}
+			else {
+				h = (r - g) / d + 4.0f;
+			}
+			return h * 60.0f;
+		}
+
+		// wrap hue into [0, 360)
+		float WrapHue(float h) {
+			return h - 360.0f * std::floor(h / 360.0f);
+		}
+	}
+
+	ColourHSV ToHSV(const Colour& c) {
+		float r = c.GetRed() * Inv255, g = c.GetGreen() * Inv255, b = c.GetBlue() * Inv255;
+		float mx = std::max(r, std::max(g, b));
+		float mn = std::min(r, std::min(g, b));
+		float d = mx - mn;
+		return { Hue(r, g, b, mx, d), mx > 0.0f ? d / mx : 0.0f, mx, c.GetAlpha() * Inv255 };
+	}
+
+	ColourHSL ToHSL(const Colour& c) {
+		float r = c.GetRed() * Inv255, g = c.GetGreen() * Inv255, b = c.GetBlue() * Inv255;
+		float mx = std::max(r, std::max(g, b));
+		float mn = std::min(r, std::min(g, b));
+		float d = mx - mn;
+		float l = (mx + mn) * 0.5f;
+		float s = d > 0.0f ? d / (1.0f - std::fabs(2.0f * l - 1.0f)) : 0.0f;
+		return { Hue(r, g, b, mx, d), s, l, c.GetAlpha() * Inv255 };
+	}
+
+	Colour FromHSV(const ColourHSV& hsv) {
+		// f(n) = v - v * s * clamp(min(k, 4 - k), 0, 1) with k = (n + h / 60) mod 6
+		float h = WrapHue(hsv.h) / 60.0f;
+		float channels[3];
+		const float n[3] = { 5.0f, 3.0f, 1.0f };
+		for (int i = 0; i < 3; ++i) {
+			float k = n[i] + h;
+			if (k >= 6.0f) {
+				k -= 6.0f;
+			}
+			float t = MinPs(MaxPs(MinPs(k, 4.0f - k), 0.0f), 1.0f);
+			channels[i] = hsv.v - hsv.v * hsv.s * t;
+		}
+		return Colour(ToByte(channels[0]), ToByte(channels[1]), ToByte(channels[2]), ToByte(hsv.a));
+	}
+
+	Colour FromHSL(const ColourHSL& hsl) {
+		// f(n) = l - a * clamp(min(k - 3, 9 - k), -1, 1) with k = (n + h / 30) mod 12
+		float h = WrapHue(hsl.h) / 30.0f;
+		float a = hsl.s * MinPs(hsl.l, 1.0f - hsl.l);
+		float channels[3];
+		const float n[3] = { 0.0f, 8.0f, 4.0f };
+		for (int i = 0; i < 3; ++i) {
+			float k = n[i] + h;
+			if (k >= 12.0f) {
+				k -= 12.0f;
+			}
+			float t = MinPs(MaxPs(MinPs(k - 3.0f, 9.0f - k), -1.0f), 1.0f);
+			channels[i] = hsl.l - a * t;
+		}
+		return Colour(ToByte(channels[0]), ToByte(channels[1]), ToByte(channels[2]), ToByte(hsl.a));
+	}
+
+#if MATHCLASSES_SSE2
+	namespace {
+		using namespace Simd;
+
+		__m128 Floor4(__m128 x) {
+			__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+			t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+			// from 2^23 up every float is already an integer (and too big for cvttps)
+			__m128 absX = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+			return Select(_mm_cmplt_ps(absX, _mm_set1_ps(8388608.0f)), t, x);
+		}
+
+		__m128 WrapHue4(__m128 h) {
+			__m128 turns = Floor4(_mm_div_ps(h, _mm_set1_ps(360.0f)));
+			return _mm_sub_ps(h, _mm_mul_ps(turns, _mm_set1_ps(360.0f)));
+		}
+
+		// branch-free version of Hue(): every candidate is computed and the right one selected
+		__m128 Hue4(const Channels4& c, __m128 mx, __m128 d) {
+			__m128 zero = _mm_setzero_ps();
+			__m128 safeD = _mm_max_ps(d, _mm_set1_ps(FLT_MIN));
+			__m128 hr = _mm_div_ps(_mm_sub_ps(c.g, c.b), safeD);
+			hr = _mm_add_ps(hr, _mm_and_ps(_mm_cmplt_ps(hr, zero), _mm_set1_ps(6.0f)));
+			__m128 hg = _mm_add_ps(_mm_div_ps(_mm_sub_ps(c.b, c.r), safeD), _mm_set1_ps(2.0f));
+			__m128 hb = _mm_add_ps(_mm_div_ps(_mm_sub_ps(c.r, c.g), safeD), _mm_set1_ps(4.0f));
+
+			__m128 h = Select(_mm_cmpeq_ps(mx, c.r), hr, Select(_mm_cmpeq_ps(mx, c.g), hg, hb));
+			return _mm_and_ps(_mm_cmpgt_ps(d, zero), _mm_mul_ps(h, _mm_set1_ps(60.0f)));
+		}
+
+		// four SoA registers -> four AoS structs of four floats
+		void Store4(__m128 x, __m128 y, __m128 z, __m128 w, float* out) {
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(out, x);
+			_mm_storeu_ps(out + 4, y);
+			_mm_storeu_ps(out + 8, z);
+			_mm_storeu_ps(out + 12, w);
+		}
+
+		void Load4(const float* in, __m128& x, __m128& y, __m128& z, __m128& w) {
+			x = _mm_loadu_ps(in);
+			y = _mm_loadu_ps(in + 4);
+			z = _mm_loadu_ps(in + 8);
+			w = _mm_loadu_ps(in + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+		}
+	}
+#endif
+
+	void ToHSV(const Colour* in, ColourHSV* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			Channels4 c = Unpack4(in + i);
+			__m128 mx = _mm_max_ps(c.r, _mm_max_ps(c.g, c.b));
+			__m128 mn = _mm_min_ps(c.r, _mm_min_ps(c.g, c.b));
+			__m128 d = _mm_sub_ps(mx, mn);
+			__m128 s = _mm_and_ps(_mm_cmpgt_ps(mx, _mm_setzero_ps()), _mm_div_ps(d, _mm_max_ps(mx, _mm_set1_ps(FLT_MIN))));
+			Store4(Hue4(c, mx, d), s, mx, c.a, &out[i].h);
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = ToHSV(in[i]);
+		}
+	}
+
+	void ToHSL(const Colour* in, ColourHSL* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			Channels4 c = Unpack4(in + i);
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 mx = _mm_max_ps(c.r, _mm_max_ps(c.g, c.b));
+			__m128 mn = _mm_min_ps(c.r, _mm_min_ps(c.g, c.b));
+			__m128 d = _mm_sub_ps(mx, mn);
+			__m128 l = _mm_mul_ps(_mm_add_ps(mx, mn), _mm_set1_ps(0.5f));
+			__m128 twoLMinusOne = _mm_sub_ps(_mm_add_ps(l, l), one);
+			__m128 absTerm = _mm_max_ps(twoLMinusOne, _mm_sub_ps(_mm_setzero_ps(), twoLMinusOne));
+			__m128 denom = _mm_max_ps(_mm_sub_ps(one, absTerm), _mm_set1_ps(FLT_MIN));
+			__m128 s = _mm_and_ps(_mm_cmpgt_ps(d, _mm_setzero_ps()), _mm_div_ps(d, denom));
+			Store4(Hue4(c, mx, d), s, l, c.a, &out[i].h);
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = ToHSL(in[i]);
+		}
+	}
+
+	void FromHSV(const ColourHSV* in, Colour* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			__m128 h, s, v, a;
+			Load4(&in[i].h, h, s, v, a);
+			h = _mm_div_ps(WrapHue4(h), _mm_set1_ps(60.0f));
+			__m128 vs = _mm_mul_ps(v, s);
+			__m128 six = _mm_set1_ps(6.0f), four = _mm_set1_ps(4.0f);
+			__m128 channels[3];
+			const float n[3] = { 5.0f, 3.0f, 1.0f };
+			for (int ch = 0; ch < 3; ++ch) {
+				__m128 k = _mm_add_ps(_mm_set1_ps(n[ch]), h);
+				k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, six), six));
+				__m128 t = _mm_min_ps(k, _mm_sub_ps(four, k));
+				t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+				channels[ch] = _mm_sub_ps(v, _mm_mul_ps(vs, t));
+			}
+			Pack4(channels[0], channels[1], channels[2], a, out + i);
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = FromHSV(in[i]);
+		}
+	}
+
+	void FromHSL(const ColourHSL* in, Colour* out, size_t count) {
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		for (; i + 4 <= count; i += 4) {
+			__m128 h, s, l, alpha;
+			Load4(&in[i].h, h, s, l, alpha);
+			__m128 one = _mm_set1_ps(1.0f);
+			h = _mm_div_ps(WrapHue4(h), _mm_set1_ps(30.0f));
+			__m128 a = _mm_mul_ps(s, _mm_min_ps(l, _mm_sub_ps(one, l)));
+			__m128 twelve = _mm_set1_ps(12.0f);
+			__m128 channels[3];
+			const float n[3] = { 0.0f, 8.0f, 4.0f };
+			for (int ch = 0; ch < 3; ++ch) {
+				__m128 k = _mm_add_ps(_mm_set1_ps(n[ch]), h);
+				k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, twelve), twelve));
+				__m128 t = _mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)), _mm_sub_ps(_mm_set1_ps(9.0f), k));
+				t = _mm_min_ps(_mm_max_ps(t, _mm_set1_ps(-1.0f)), one);
+				channels[ch] = _mm_sub_ps(l, _mm_mul_ps(a, t));
+			}
+			Pack4(channels[0], channels[1], channels[2], alpha, out + i);
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = FromHSL(in[i]);
+		}
+	}
+}
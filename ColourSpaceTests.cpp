@@ -0,0 +1,81 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/ColourSpace.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Colour;
+using ::MathClasses::ColourHSV;
+using ::MathClasses::ColourHSL;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ColourSpaceTests)
+	{
+	public:
+		// primaries map to the expected hues
+		TEST_METHOD(ToHSVPrimaries)
+		{
+			ColourHSV red = ToHSV(Colour(255, 0, 0, 255));
+			Assert::AreEqual(0.f, red.h, MAX_FLOAT_DELTA);
+			Assert::AreEqual(1.f, red.s, MAX_FLOAT_DELTA);
+			Assert::AreEqual(1.f, red.v, MAX_FLOAT_DELTA);
+
+			ColourHSV green = ToHSV(Colour(0, 255, 0, 255));
+			Assert::AreEqual(120.f, green.h, MAX_FLOAT_DELTA);
+
+			ColourHSV blue = ToHSV(Colour(0, 0, 255, 128));
+			Assert::AreEqual(240.f, blue.h, MAX_FLOAT_DELTA);
+			Assert::AreEqual(128.f / 255.f, blue.a, MAX_FLOAT_DELTA);
+		}
+
+		// grey has no hue or saturation, lightness is the midpoint
+		TEST_METHOD(ToHSLGrey)
+		{
+			ColourHSL grey = ToHSL(Colour(51, 51, 51, 255));
+			Assert::AreEqual(0.f, grey.h, MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.f, grey.s, MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.2f, grey.l, MAX_FLOAT_DELTA);
+		}
+
+		// hue outside [0, 360) wraps around
+		TEST_METHOD(FromHSVWrapsHue)
+		{
+			Assert::IsTrue(Colour(0, 0, 255, 255) == FromHSV(ColourHSV{ -120.f, 1.f, 1.f, 1.f }));
+			Assert::IsTrue(Colour(255, 255, 0, 255) == FromHSL(ColourHSL{ 420.f, 1.f, 0.5f, 1.f }));
+		}
+
+		// batch conversions match the single value ones and round trip
+		TEST_METHOD(BatchRoundTrip)
+		{
+			std::vector<Colour> colours;
+			for (int i = 0; i < 4099; ++i)
+			{
+				colours.push_back(Colour((i * 37) & 0xff, (i * 11) & 0xff, (i * 101) & 0xff, i & 0xff));
+			}
+
+			std::vector<ColourHSV> hsv(colours.size());
+			std::vector<ColourHSL> hsl(colours.size());
+			ToHSV(colours.data(), hsv.data(), colours.size());
+			ToHSL(colours.data(), hsl.data(), colours.size());
+
+			std::vector<Colour> fromHsv(colours.size()), fromHsl(colours.size());
+			FromHSV(hsv.data(), fromHsv.data(), hsv.size());
+			FromHSL(hsl.data(), fromHsl.data(), hsl.size());
+
+			for (size_t i = 0; i < colours.size(); ++i)
+			{
+				ColourHSV expected = ToHSV(colours[i]);
+				Assert::AreEqual(expected.h, hsv[i].h, 1e-3f);
+				Assert::AreEqual(expected.s, hsv[i].s, MAX_FLOAT_DELTA);
+				Assert::AreEqual(expected.v, hsv[i].v, MAX_FLOAT_DELTA);
+
+				Assert::IsTrue(colours[i] == fromHsv[i]);
+				Assert::IsTrue(colours[i] == fromHsl[i]);
+			}
+		}
+	};
+}
@@ -4,6 +4,8 @@
 #include "Utils.h"
 #include "MathHeaders/Colour.h"
 #include <UnitTestLib.h>
+#include <limits>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using ::MathClasses::Colour;
@@ -115,5 +117,100 @@ namespace MathLibraryTests
 			Assert::AreEqual(actual.GetBlue(), (Byte)0);
 			Assert::AreEqual(actual.GetAlpha(), (Byte)0);
 		}
+
+		// saturating add and subtract clamp each channel
+		TEST_METHOD(SaturatingAddSubtract)
+		{
+			Colour a(200, 100, 10, 255);
+			Colour b(100, 100, 20, 1);
+
+			Assert::AreEqual(UnitLib::BuildColour(255, 200, 30, 255), (a + b).colour);
+			Assert::AreEqual(UnitLib::BuildColour(100, 0, 0, 254), (a - b).colour);
+
+			a += b;
+			Assert::AreEqual(UnitLib::BuildColour(255, 200, 30, 255), a.colour);
+		}
+
+		// scaling rounds and clamps
+		TEST_METHOD(Scale)
+		{
+			Colour actual(200, 100, 10, 255);
+
+			Assert::AreEqual(UnitLib::BuildColour(100, 50, 5, 128), (actual * 0.5f).colour);
+			Assert::AreEqual(UnitLib::BuildColour(255, 200, 20, 255), (actual * 2.0f).colour);
+			Assert::AreEqual(UnitLib::BuildColour(0, 0, 0, 0), (actual * -1.0f).colour);
+		}
+
+		// lerp end points and midpoint
+		TEST_METHOD(Lerp)
+		{
+			Colour a(0, 100, 200, 255);
+			Colour b(200, 100, 0, 55);
+
+			Assert::IsTrue(a == Colour::Lerp(a, b, 0.0f));
+			Assert::IsTrue(b == Colour::Lerp(a, b, 1.0f));
+			Assert::IsTrue(b == Colour::Lerp(a, b, 3.0f));
+			Assert::AreEqual(UnitLib::BuildColour(100, 100, 100, 155), Colour::Lerp(a, b, 0.5f).colour);
+		}
+		// a NaN weight clamps to 0 in both the single and the batch lerp
+		TEST_METHOD(LerpNaN)
+		{
+			Colour a(0, 100, 200, 255);
+			Colour b(200, 100, 0, 55);
+			float nan = std::numeric_limits<float>::quiet_NaN();
+
+			Assert::IsTrue(a == Colour::Lerp(a, b, nan));
+			std::vector<Colour> as(9, a), bs(9, b), out(9);
+			MathClasses::CrossFade(as.data(), bs.data(), out.data(), 9, nan);
+			for (const Colour& c : out)
+			{
+				Assert::IsTrue(a == c);
+			}
+		}
+
+		// batch functions match the single colour operators
+		TEST_METHOD(BatchOperations)
+		{
+			const size_t count = 23;
+			std::vector<Colour> a(count), b(count), out(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				a[i] = Colour((Byte)(i * 11), (Byte)(i * 29), (Byte)(250 - i), (Byte)(i * 7));
+				b[i] = Colour((Byte)(i * 13), (Byte)(200 - i), (Byte)(i * 3), (Byte)(i * 17));
+			}
+
+			MathClasses::AddSaturate(a.data(), b.data(), out.data(), count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::IsTrue(a[i] + b[i] == out[i]);
+			}
+
+			MathClasses::SubtractSaturate(a.data(), b.data(), out.data(), count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::IsTrue(a[i] - b[i] == out[i]);
+			}
+
+			MathClasses::CrossFade(a.data(), b.data(), out.data(), count, 0.3f);
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::IsTrue(Colour::Lerp(a[i], b[i], 0.3f) == out[i]);
+			}
+
+			MathClasses::Average(a.data(), b.data(), out.data(), count);
+			Assert::AreEqual((Byte)((a[5].GetRed() + b[5].GetRed() + 1) / 2), out[5].GetRed());
+			Assert::AreEqual((Byte)((a[21].GetBlue() + b[21].GetBlue() + 1) / 2), out[21].GetBlue());
+		}
+
+		// gradient runs from the first colour to the last
+		TEST_METHOD(Gradient)
+		{
+			std::vector<Colour> out(9);
+			MathClasses::FillGradient(out.data(), out.size(), Colour(0, 0, 0, 255), Colour(255, 128, 0, 255));
+
+			Assert::AreEqual(UnitLib::BuildColour(0, 0, 0, 255), out[0].colour);
+			Assert::AreEqual(UnitLib::BuildColour(128, 64, 0, 255), out[4].colour);
+			Assert::AreEqual(UnitLib::BuildColour(255, 128, 0, 255), out[8].colour);
+		}
 	};
 }
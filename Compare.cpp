@@ -0,0 +1,197 @@
+#include "MathHeaders/Compare.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace MathClasses {
+	namespace {
+		// Maps float bits onto integers in the order of the values, -0 and +0 both to 0
+		inline int32_t Ordered(float value) {
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? static_cast<int32_t>(0x80000000u - static_cast<uint32_t>(bits)) : bits;
+		}
+
+		inline uint32_t UlpLimit(const Tolerance& tolerance) {
+			return std::min(tolerance.maxUlps, Tolerance::MaxUlps);
+		}
+
+#if MATHCLASSES_SSE2
+		// The tolerance broadcast once per batch; the lane tests below match Near(float) exactly
+		struct Lanes {
+			__m128 epsilon;
+			__m128i ulps, negativeUlps;
+
+			explicit Lanes(const Tolerance& tolerance)
+				: epsilon(_mm_set1_ps(tolerance.epsilon)),
+				ulps(_mm_set1_epi32(static_cast<int32_t>(UlpLimit(tolerance)))),
+				negativeUlps(_mm_set1_epi32(-static_cast<int32_t>(UlpLimit(tolerance)))) {}
+		};
+
+		inline __m128i Ordered(__m128 value) {
+			__m128i bits = _mm_castps_si128(value);
+			__m128i negative = _mm_srai_epi32(bits, 31);
+			__m128i flipped = _mm_sub_epi32(_mm_set1_epi32(static_cast<int32_t>(0x80000000u)), bits);
+			return _mm_or_si128(_mm_and_si128(negative, flipped), _mm_andnot_si128(negative, bits));
+		}
+
+		// All ones in the lanes that are near. The mode is a template argument so batches pick the
+		// test once rather than per element.
+		template<CompareMode Mode>
+		inline __m128 Near4(__m128 a, __m128 b, const Lanes& lanes) {
+			__m128 equal = _mm_cmpeq_ps(a, b);
+			__m128 within;
+			if (Mode == CompareMode::Ulp) {
+				__m128i distance = _mm_sub_epi32(Ordered(a), Ordered(b));
+				__m128i outside = _mm_or_si128(_mm_cmpgt_epi32(distance, lanes.ulps), _mm_cmplt_epi32(distance, lanes.negativeUlps));
+				within = _mm_andnot_ps(_mm_castsi128_ps(outside), _mm_cmpord_ps(a, b));
+			} else {
+				__m128 sign = _mm_set1_ps(-0.0f);
+				__m128 difference = _mm_andnot_ps(sign, _mm_sub_ps(a, b));
+				__m128 limit = lanes.epsilon;
+				if (Mode == CompareMode::Relative) {
+					__m128 scale = _mm_max_ps(_mm_andnot_ps(sign, a), _mm_andnot_ps(sign, b));
+					limit = _mm_mul_ps(limit, _mm_min_ps(scale, _mm_set1_ps(FLT_MAX)));
+				}
+				within = _mm_cmple_ps(difference, limit);
+			}
+			return _mm_or_ps(equal, within);
+		}
+
+		template<CompareMode Mode>
+		inline bool Near4x4(const float* a, const float* b, const Lanes& lanes) {
+			__m128 all = _mm_and_ps(_mm_and_ps(Near4<Mode>(_mm_loadu_ps(a), _mm_loadu_ps(b), lanes), Near4<Mode>(_mm_loadu_ps(a + 4), _mm_loadu_ps(b + 4), lanes)),
+				_mm_and_ps(Near4<Mode>(_mm_loadu_ps(a + 8), _mm_loadu_ps(b + 8), lanes), Near4<Mode>(_mm_loadu_ps(a + 12), _mm_loadu_ps(b + 12), lanes)));
+			return _mm_movemask_ps(all) == 0xf;
+		}
+
+		// The ninth element goes through lane 0 of a scalar load, the other lanes compare 0 with 0
+		template<CompareMode Mode>
+		inline bool Near3x3(const float* a, const float* b, const Lanes& lanes) {
+			__m128 all = _mm_and_ps(_mm_and_ps(Near4<Mode>(_mm_loadu_ps(a), _mm_loadu_ps(b), lanes), Near4<Mode>(_mm_loadu_ps(a + 4), _mm_loadu_ps(b + 4), lanes)),
+				Near4<Mode>(_mm_load_ss(a + 8), _mm_load_ss(b + 8), lanes));
+			return _mm_movemask_ps(all) == 0xf;
+		}
+#else
+		bool NearElements(const float* a, const float* b, int count, const Tolerance& tolerance) {
+			bool near = true;
+			for (int i = 0; i < count; ++i) {
+				near &= Near(a[i], b[i], tolerance);
+			}
+			return near;
+		}
+#endif
+
+		// Calls body with the tolerance's mode as a compile-time constant
+		template<typename Body>
+		auto WithMode(CompareMode mode, Body body) {
+			switch (mode) {
+			case CompareMode::Absolute: return body(std::integral_constant<CompareMode, CompareMode::Absolute>());
+			case CompareMode::Relative: return body(std::integral_constant<CompareMode, CompareMode::Relative>());
+			default: return body(std::integral_constant<CompareMode, CompareMode::Ulp>());
+			}
+		}
+
+		// near(i) gives pair i; the bits are gathered a word at a time
+		template<typename NearFn>
+		size_t FillMask(size_t count, uint64_t* mask, NearFn near) {
+			size_t total = 0;
+			for (size_t word = 0; word * 64 < count; ++word) {
+				size_t begin = word * 64, end = std::min(count, begin + 64);
+				uint64_t bits = 0;
+				for (size_t i = begin; i < end; ++i) {
+					bits |= static_cast<uint64_t>(near(i)) << (i - begin);
+				}
+				mask[word] = bits;
+				for (uint64_t rest = bits; rest; rest &= rest - 1) {
+					++total;
+				}
+			}
+			return total;
+		}
+	}
+
+	bool Near(float a, float b, const Tolerance& tolerance) {
+		if (a == b) {
+			return true;
+		}
+		switch (tolerance.mode) {
+		case CompareMode::Absolute:
+			return std::fabs(a - b) <= tolerance.epsilon;
+		case CompareMode::Relative:
+			// the scale is capped so an infinity is not relatively near every finite value
+			return std::fabs(a - b) <= tolerance.epsilon * std::min(std::max(std::fabs(a), std::fabs(b)), FLT_MAX);
+		default:
+			if (std::isnan(a) || std::isnan(b)) {
+				return false;
+			}
+			int64_t distance = static_cast<int64_t>(Ordered(a)) - Ordered(b);
+			return (distance < 0 ? -distance : distance) <= static_cast<int64_t>(UlpLimit(tolerance));
+		}
+	}
+
+	bool Near(const Matrix3& a, const Matrix3& b, const Tolerance& tolerance) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) { return Near3x3<decltype(mode)::value>(&a.m1, &b.m1, lanes); });
+#else
+		return NearElements(&a.m1, &b.m1, 9, tolerance);
+#endif
+	}
+
+	bool Near(const Matrix4& a, const Matrix4& b, const Tolerance& tolerance) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) { return Near4x4<decltype(mode)::value>(&a.m1, &b.m1, lanes); });
+#else
+		return NearElements(&a.m1, &b.m1, 16, tolerance);
+#endif
+	}
+
+	size_t Compare(const Matrix3* a, const Matrix3* b, size_t count, const Tolerance& tolerance, uint64_t* mask) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) {
+			return FillMask(count, mask, [&](size_t i) { return Near3x3<decltype(mode)::value>(&a[i].m1, &b[i].m1, lanes); });
+		});
+#else
+		return FillMask(count, mask, [&](size_t i) { return NearElements(&a[i].m1, &b[i].m1, 9, tolerance); });
+#endif
+	}
+
+	size_t Compare(const Matrix4* a, const Matrix4* b, size_t count, const Tolerance& tolerance, uint64_t* mask) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) {
+			return FillMask(count, mask, [&](size_t i) { return Near4x4<decltype(mode)::value>(&a[i].m1, &b[i].m1, lanes); });
+		});
+#else
+		return FillMask(count, mask, [&](size_t i) { return NearElements(&a[i].m1, &b[i].m1, 16, tolerance); });
+#endif
+	}
+
+	size_t CompareWith(const Matrix3& reference, const Matrix3* items, size_t count, const Tolerance& tolerance, uint64_t* mask) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) {
+			return FillMask(count, mask, [&](size_t i) { return Near3x3<decltype(mode)::value>(&reference.m1, &items[i].m1, lanes); });
+		});
+#else
+		return FillMask(count, mask, [&](size_t i) { return NearElements(&reference.m1, &items[i].m1, 9, tolerance); });
+#endif
+	}
+
+	size_t CompareWith(const Matrix4& reference, const Matrix4* items, size_t count, const Tolerance& tolerance, uint64_t* mask) {
+#if MATHCLASSES_SSE2
+		Lanes lanes(tolerance);
+		return WithMode(tolerance.mode, [&](auto mode) {
+			return FillMask(count, mask, [&](size_t i) { return Near4x4<decltype(mode)::value>(&reference.m1, &items[i].m1, lanes); });
+		});
+#else
+		return FillMask(count, mask, [&](size_t i) { return NearElements(&reference.m1, &items[i].m1, 16, tolerance); });
+#endif
+	}
+}
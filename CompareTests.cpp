@@ -0,0 +1,89 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Compare.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(CompareTests)
+	{
+	public:
+		TEST_METHOD(MatrixEquals)
+		{
+			Matrix3 a3 = Matrix3::MakeRotateZ(0.5f), b3 = a3;
+			b3.m9 += 1e-6f;
+			Assert::IsTrue(a3.Equals(b3));
+			b3.m9 += 1e-3f;
+			Assert::IsFalse(a3.Equals(b3));
+			Assert::IsTrue(a3.Equals(b3, 1e-2f));
+
+			Matrix4 a4 = Matrix4::MakeEuler(0.1f, 0.2f, 0.3f), b4 = a4;
+			b4.m13 = 1e-6f;
+			Assert::IsTrue(a4.Equals(b4));
+			b4.m16 = NAN;
+			Assert::IsFalse(a4.Equals(b4, 1e10f));
+		}
+
+		TEST_METHOD(Modes)
+		{
+			Assert::IsTrue(Near(1000.f, 1000.005f, Tolerance::Relative(1e-5f)));
+			Assert::IsFalse(Near(1000.f, 1000.005f, Tolerance::Absolute(1e-5f)));
+			Assert::IsFalse(Near(1e-3f, 2e-3f, Tolerance::Relative(1e-5f)));
+			Assert::IsTrue(Near(1e-3f, 2e-3f, Tolerance::Absolute(1e-2f)));
+
+			float next = std::nextafter(1.f, 2.f);
+			Assert::IsTrue(Near(1.f, std::nextafter(next, 2.f), Tolerance::Ulps(2)));
+			Assert::IsFalse(Near(1.f, std::nextafter(next, 2.f), Tolerance::Ulps(1)));
+			Assert::IsTrue(Near(0.f, -0.f, Tolerance::Ulps(0)));
+			Assert::IsTrue(Near(-FLT_TRUE_MIN, FLT_TRUE_MIN, Tolerance::Ulps(2)));
+
+			Assert::IsTrue(Near(INFINITY, INFINITY, Tolerance::Relative()));
+			Assert::IsFalse(Near(INFINITY, FLT_MAX, Tolerance::Relative(0.5f)));
+			Assert::IsFalse(Near(INFINITY, -INFINITY, Tolerance::Ulps(Tolerance::MaxUlps)));
+			Assert::IsFalse(Near(NAN, NAN, Tolerance::Ulps(Tolerance::MaxUlps)));
+		}
+
+		// masks set one bit per pair and agree with Near
+		TEST_METHOD(BatchMasks)
+		{
+			const size_t count = 70;
+			Matrix4 a[count], b[count];
+			Matrix3 c[count];
+			for (size_t i = 0; i < count; ++i)
+			{
+				a[i] = Matrix4::MakeRotateY(0.01f * i);
+				b[i] = a[i];
+				c[i] = Matrix3::MakeRotateZ(0.01f * i);
+				if (i % 3 == 0)
+				{
+					b[i].m7 += 0.5f;
+					c[i].m9 += 0.5f;
+				}
+			}
+
+			uint64_t mask[2];
+			Assert::AreEqual(size_t(46), Compare(a, b, count, Tolerance::Ulps(), mask));
+			for (size_t i = 0; i < count; ++i)
+			{
+				bool bit = ((mask[i / 64] >> (i % 64)) & 1) != 0;
+				Assert::AreEqual(i % 3 != 0, bit);
+				Assert::AreEqual(Near(a[i], b[i], Tolerance::Ulps()), bit);
+			}
+			Assert::AreEqual(uint64_t(0), mask[1] >> (count - 64));
+
+			Assert::AreEqual(size_t(1), CompareWith(a[5], a, count, Tolerance::Absolute(), mask));
+			Assert::AreEqual(uint64_t(1) << 5, mask[0]);
+
+			Matrix3 reference = Matrix3::MakeRotateZ(0.0f);
+			Assert::AreEqual(size_t(0), CompareWith(reference, c, count, Tolerance::Relative(), mask));
+			Assert::AreEqual(size_t(count), Compare(c, c, count, Tolerance::Absolute(0.f), mask));
+		}
+	};
+}
@@ -0,0 +1,54 @@
+#include "MathHeaders/Format.h"
+#include <algorithm>
+#include <cstring>
+
+namespace MathClasses {
+	namespace Format {
+		Writer::Writer(char* buffer, size_t size)
+			: out(size > 0 ? buffer : nullptr), end(size > 0 ? buffer + size - 1 : nullptr), length(0) {}
+
+		void Writer::Put(char c) {
+			if (out < end) {
+				*out++ = c;
+			}
+			++length;
+		}
+
+		void Writer::Put(const char* text) {
+			size_t n = std::strlen(text);
+			size_t fits = std::min(n, static_cast<size_t>(end - out));
+			if (fits > 0) {
+				std::memcpy(out, text, fits);
+			}
+			out += fits;
+			length += n;
+		}
+
+		void Writer::Put(float value, std::chars_format format, int precision) {
+			// 3.4e38 in fixed notation with 50 decimals still fits
+			char scratch[128];
+			precision = std::min(std::max(precision, 0), 50);
+			std::to_chars_result result = std::to_chars(scratch, scratch + sizeof(scratch), value, format, precision);
+			size_t n = static_cast<size_t>(result.ptr - scratch);
+			size_t fits = std::min(n, static_cast<size_t>(end - out));
+			if (fits > 0) {
+				std::memcpy(out, scratch, fits);
+			}
+			out += fits;
+			length += n;
+		}
+
+		void Writer::PutHex(unsigned value) {
+			const char* digits = "0123456789ABCDEF";
+			Put(digits[(value >> 4) & 15]);
+			Put(digits[value & 15]);
+		}
+
+		size_t Writer::Finish() {
+			if (end != nullptr) {
+				*out = '\0';
+			}
+			return length;
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "MathHeaders/Format.h"
+#include <cstring>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Vector3;
+using ::MathClasses::Vector4;
+using ::MathClasses::Matrix3;
+using ::MathClasses::Matrix4;
+using ::MathClasses::Colour;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(FormatTests)
+	{
+	public:
+		// the default formats are the ones ToString has always produced
+		TEST_METHOD(VectorDefaultFormat)
+		{
+			char buffer[64];
+			size_t length = Vector3(1.5f, -2.25f, 10.f).FormatTo(buffer, sizeof(buffer));
+			Assert::AreEqual("(1.500000, -2.250000, 10.000000)", buffer);
+			Assert::AreEqual(std::strlen(buffer), length);
+
+			Vector4(0.f, 1.f, -0.5f, 2.f).FormatTo(buffer, sizeof(buffer));
+			Assert::AreEqual("(0.000000, 1.000000, -0.500000, 2.000000)", buffer);
+			Assert::AreEqual(buffer, Vector4(0.f, 1.f, -0.5f, 2.f).ToString().c_str());
+		}
+
+		TEST_METHOD(MatrixDefaultFormat)
+		{
+			char buffer[256];
+			Matrix3(1, 0.5f, 0, 0, 1, 0, 1234567.f, 0.125f, 1).FormatTo(buffer, sizeof(buffer));
+			Assert::AreEqual("[1, 0.5, 0], [0, 1, 0], [1.23457e+06, 0.125, 1]", buffer);
+
+			Matrix4 m = Matrix4::MakeTranslation(1.f, -2.5f, 3.125f);
+			m.FormatTo(buffer, sizeof(buffer));
+			Assert::AreEqual(
+				"[1.00, 0.00, 0.00, 0.00]\n"
+				"[0.00, 1.00, 0.00, 0.00]\n"
+				"[0.00, 0.00, 1.00, 0.00]\n"
+				"[1.00, -2.50, 3.12, 1.00]", buffer);
+			Assert::AreEqual(buffer, m.ToString().c_str());
+		}
+
+		TEST_METHOD(Precision)
+		{
+			char buffer[256];
+			Vector3(1.f / 3.f, 2.f, -1.f).FormatTo(buffer, sizeof(buffer), 2);
+			Assert::AreEqual("(0.33, 2.00, -1.00)", buffer);
+
+			Matrix3::identity.FormatTo(buffer, sizeof(buffer), 0);
+			Assert::AreEqual("[1, 0, 0], [0, 1, 0], [0, 0, 1]", buffer);
+
+			Matrix4::MakeScale(0.5f, 1.f, 2.f).FormatTo(buffer, sizeof(buffer), 0);
+			Assert::AreEqual("[0, 0, 0, 0]\n[0, 1, 0, 0]\n[0, 0, 2, 0]\n[0, 0, 0, 1]", buffer);
+		}
+
+		// a short buffer gets a terminated prefix and the full length comes back
+		TEST_METHOD(Truncation)
+		{
+			char buffer[8];
+			std::memset(buffer, 'x', sizeof(buffer));
+			size_t length = Vector3(1.f, 2.f, 3.f).FormatTo(buffer, sizeof(buffer));
+			Assert::AreEqual(size_t(30), length);
+			Assert::IsTrue(std::strcmp("(1.0000", buffer) == 0);
+
+			Assert::AreEqual(size_t(30), Vector3(1.f, 2.f, 3.f).FormatTo(nullptr, 0));
+		}
+
+		TEST_METHOD(ColourHex)
+		{
+			char buffer[16];
+			Assert::AreEqual(size_t(9), Colour(255, 128, 0, 192).FormatTo(buffer, sizeof(buffer)));
+			Assert::AreEqual("#FF8000C0", buffer);
+			Assert::AreEqual("#000000FF", Colour(0, 0, 0, 255).ToString().c_str());
+		}
+	};
+}
@@ -0,0 +1,174 @@
+#include "Fuzz.h"
+#include "MathHeaders/Colour.h"
+#include "MathHeaders/ColourHistogram.h"
+#include "MathHeaders/ColourSpace.h"
+#include "MathHeaders/Tonemap.h"
+#include <vector>
+
+using MathClasses::Colour;
+using MathClasses::ColourHSL;
+using MathClasses::ColourHSV;
+
+namespace {
+	// batch size; odd so the scalar tails are exercised as well
+	const size_t Batch = 1021;
+
+	std::vector<Colour> RandomColours(Fuzz::Rng& rng, size_t count) {
+		std::vector<Colour> c(count);
+		for (Colour& x : c) {
+			x.colour = rng.Bits();
+		}
+		return c;
+	}
+
+	std::string DescribeColour(const Colour& c) {
+		return Fuzz::Format("colour 0x%08x", c.colour);
+	}
+
+	int Channel(const Colour& c, int ch) {
+		return static_cast<int>((c.colour >> (24 - ch * 8)) & 0xff);
+	}
+
+	void CompareColours(Fuzz::Context& fuzz, const Colour& expected, const Colour& actual, const std::function<std::string()>& describe) {
+		for (int ch = 0; ch < 4; ++ch) {
+			fuzz.CompareInt(Channel(expected, ch), Channel(actual, ch), describe);
+		}
+	}
+}
+
+FUZZ_CHECK(Colour_ToHSV_Batch, 2, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<Colour> in = RandomColours(fuzz.rng, Batch);
+		std::vector<ColourHSV> out(Batch);
+		MathClasses::ToHSV(in.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			ColourHSV ref = MathClasses::ToHSV(in[i]);
+			auto describe = [&] { return DescribeColour(in[i]); };
+			fuzz.Compare(ref.h, out[i].h, describe);
+			fuzz.Compare(ref.s, out[i].s, describe);
+			fuzz.Compare(ref.v, out[i].v, describe);
+			fuzz.Compare(ref.a, out[i].a, describe);
+		}
+	}
+}
+
+FUZZ_CHECK(Colour_ToHSL_Batch, 2, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<Colour> in = RandomColours(fuzz.rng, Batch);
+		std::vector<ColourHSL> out(Batch);
+		MathClasses::ToHSL(in.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			ColourHSL ref = MathClasses::ToHSL(in[i]);
+			auto describe = [&] { return DescribeColour(in[i]); };
+			fuzz.Compare(ref.h, out[i].h, describe);
+			fuzz.Compare(ref.s, out[i].s, describe);
+			fuzz.Compare(ref.l, out[i].l, describe);
+		}
+	}
+}
+
+// float inputs cover NaN, infinities, denormals and huge hues; channels must match exactly
+FUZZ_CHECK(Colour_FromHSV_Batch, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<ColourHSV> in(Batch);
+		for (ColourHSV& x : in) {
+			x = { fuzz.rng.Float(), fuzz.rng.Uniform(-0.1f, 1.1f), fuzz.rng.Float(), fuzz.rng.Uniform(0.0f, 1.0f) };
+		}
+		std::vector<Colour> out(Batch);
+		MathClasses::FromHSV(in.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			CompareColours(fuzz, MathClasses::FromHSV(in[i]), out[i], [&] {
+				return Fuzz::Format("hsv(%.9g, %.9g, %.9g, %.9g)", in[i].h, in[i].s, in[i].v, in[i].a);
+			});
+		}
+	}
+}
+
+FUZZ_CHECK(Colour_FromHSL_Batch, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<ColourHSL> in(Batch);
+		for (ColourHSL& x : in) {
+			x = { fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Uniform(-0.1f, 1.1f), fuzz.rng.Float() };
+		}
+		std::vector<Colour> out(Batch);
+		MathClasses::FromHSL(in.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			CompareColours(fuzz, MathClasses::FromHSL(in[i]), out[i], [&] {
+				return Fuzz::Format("hsl(%.9g, %.9g, %.9g, %.9g)", in[i].h, in[i].s, in[i].l, in[i].a);
+			});
+		}
+	}
+}
+
+// packed byte kernels against the single colour operators
+FUZZ_CHECK(Colour_BatchBlends, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<Colour> a = RandomColours(fuzz.rng, Batch), b = RandomColours(fuzz.rng, Batch), out(Batch);
+		float t = fuzz.rng.Uniform(-0.5f, 1.5f);
+		auto describe = [&](size_t i) {
+			return [&, i] { return Fuzz::Format("a 0x%08x b 0x%08x t %.9g", a[i].colour, b[i].colour, t); };
+		};
+
+		MathClasses::AddSaturate(a.data(), b.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			CompareColours(fuzz, a[i] + b[i], out[i], describe(i));
+		}
+		MathClasses::SubtractSaturate(a.data(), b.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			CompareColours(fuzz, a[i] - b[i], out[i], describe(i));
+		}
+		MathClasses::CrossFade(a.data(), b.data(), out.data(), Batch, t);
+		for (size_t i = 0; i < Batch; ++i) {
+			CompareColours(fuzz, Colour::Lerp(a[i], b[i], t), out[i], describe(i));
+		}
+		MathClasses::Average(a.data(), b.data(), out.data(), Batch);
+		for (size_t i = 0; i < Batch; ++i) {
+			for (int ch = 0; ch < 4; ++ch) {
+				fuzz.CompareInt((Channel(a[i], ch) + Channel(b[i], ch) + 1) / 2, Channel(out[i], ch), describe(i));
+			}
+		}
+	}
+}
+
+// SSE2 palette search against the scalar search
+FUZZ_CHECK(Colour_MapToPalette, 0, 0) {
+	std::vector<Colour> palette = RandomColours(fuzz.rng, 200);
+	for (size_t done = 0; done < fuzz.samples; done += Batch) {
+		std::vector<Colour> in = RandomColours(fuzz.rng, Batch);
+		std::vector<uint8_t> indices(Batch);
+		MathClasses::MapToPalette(in.data(), Batch, palette.data(), palette.size(), indices.data());
+		for (size_t i = 0; i < Batch; ++i) {
+			size_t ref = MathClasses::FindNearestPaletteIndex(in[i], palette.data(), palette.size());
+			fuzz.CompareInt(static_cast<long long>(ref), indices[i], [&] { return DescribeColour(in[i]); });
+		}
+	}
+}
+
+// fused pipeline (fast sRGB fit) against the exact per-channel reference, one 8-bit step allowed
+FUZZ_CHECK(Colour_Tonemap, 1, 0) {
+	const size_t width = 61, height = 17;
+	std::vector<float> hdr(width * height * 4);
+	std::vector<Colour> out(width * height);
+	MathClasses::TonemapCurve curves[] = { MathClasses::TonemapCurve::Clamp, MathClasses::TonemapCurve::Reinhard, MathClasses::TonemapCurve::ACES };
+
+	for (size_t done = 0; done < fuzz.samples; done += width * height) {
+		for (float& f : hdr) {
+			f = fuzz.rng.Float();
+		}
+		MathClasses::TonemapSettings settings;
+		settings.exposure = fuzz.rng.Uniform(0.0f, 4.0f);
+		settings.curve = curves[fuzz.rng.Bits() % 3];
+		MathClasses::TonemapToColour(hdr.data(), out.data(), width, height, settings);
+
+		for (size_t i = 0; i < width * height; ++i) {
+			const float* p = &hdr[i * 4];
+			auto describe = [&] { return Fuzz::Format("rgba(%.9g, %.9g, %.9g, %.9g) exposure %.9g", p[0], p[1], p[2], p[3], settings.exposure); };
+			for (int ch = 0; ch < 3; ++ch) {
+				float v = MathClasses::LinearToSrgb(MathClasses::ApplyTonemap(p[ch] * settings.exposure, settings.curve));
+				fuzz.CompareInt(static_cast<int>(v * 255.0f + 0.5f), Channel(out[i], ch), describe);
+			}
+			float a = p[3] > 0.0f ? (p[3] < 1.0f ? p[3] : 1.0f) : 0.0f;
+			fuzz.CompareInt(static_cast<int>(a * 255.0f + 0.5f), Channel(out[i], 3), describe);
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#include "Fuzz.h"
+#include "MathHeaders/Compare.h"
+#include <cfloat>
+#include <cmath>
+
+using MathClasses::CompareMode;
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Tolerance;
+
+namespace {
+	// the element near-equality written out plainly, ulps counted by stepping rather than from the bits
+	bool Reference(float a, float b, const Tolerance& tolerance) {
+		if (std::isnan(a) || std::isnan(b)) {
+			return false;
+		}
+		if (a == b) {
+			return true;
+		}
+		switch (tolerance.mode) {
+		case CompareMode::Absolute:
+			return static_cast<float>(std::fabs(a - b)) <= tolerance.epsilon;
+		case CompareMode::Relative:
+			return std::fabs(a - b) <= tolerance.epsilon * std::fmin(std::fmax(std::fabs(a), std::fabs(b)), FLT_MAX);
+		default: {
+			// distance counted by stepping, through zero counting -0 and +0 as one value
+			float low = std::fmin(a, b), high = std::fmax(a, b);
+			uint32_t steps = 0;
+			for (float x = low; x < high && steps <= tolerance.maxUlps; ++steps) {
+				x = (x == 0.0f) ? std::nextafter(0.0f, 1.0f) : std::nextafter(x, high);
+			}
+			return steps <= tolerance.maxUlps;
+		}
+		}
+	}
+
+	Tolerance RandomTolerance(Fuzz::Rng& rng) {
+		switch (rng.Next() % 3) {
+		case 0: return Tolerance::Absolute(rng.Uniform(0.0f, 1e-3f));
+		case 1: return Tolerance::Relative(rng.Uniform(0.0f, 1e-3f));
+		default: return Tolerance::Ulps(static_cast<uint32_t>(rng.Next() % 16));
+		}
+	}
+
+	// b is a near copy of a: each element unchanged, nudged a few ulps, or replaced
+	void Perturb(Fuzz::Rng& rng, const float* a, float* b, int count) {
+		for (int i = 0; i < count; ++i) {
+			uint64_t kind = rng.Next() % 8;
+			if (kind < 4) {
+				b[i] = a[i];
+			} else if (kind < 7) {
+				b[i] = a[i];
+				for (uint64_t steps = rng.Next() % 20; steps > 0; --steps) {
+					b[i] = std::nextafter(b[i], kind == 5 ? INFINITY : -INFINITY);
+				}
+			} else {
+				b[i] = rng.Float();
+			}
+		}
+	}
+}
+
+// batch masks and the matrix Near against the element-wise reference, all three modes
+FUZZ_CHECK(Compare_Matrix4, 0, 0) {
+	const size_t batch = 67;
+	Matrix4 a[batch], b[batch];
+	uint64_t mask[2];
+	for (size_t done = 0; done < fuzz.samples; done += batch) {
+		Tolerance tolerance = RandomTolerance(fuzz.rng);
+		for (size_t i = 0; i < batch; ++i) {
+			float* m = &a[i].m1;
+			for (int k = 0; k < 16; ++k) {
+				m[k] = fuzz.rng.Float();
+			}
+			// mostly near copies so both outcomes are common
+			Perturb(fuzz.rng, m, &b[i].m1, 16);
+		}
+		MathClasses::Compare(a, b, batch, tolerance, mask);
+		for (size_t i = 0; i < batch; ++i) {
+			bool expected = true;
+			for (int k = 0; k < 16; ++k) {
+				expected &= Reference((&a[i].m1)[k], (&b[i].m1)[k], tolerance);
+			}
+			auto describe = [&] { return Fuzz::Format("mode %d epsilon %.9g ulps %u, pair %zu", static_cast<int>(tolerance.mode), tolerance.epsilon, tolerance.maxUlps, i); };
+			fuzz.CompareInt(expected, (mask[i / 64] >> (i % 64)) & 1, describe);
+			fuzz.CompareInt(expected, MathClasses::Near(a[i], b[i], tolerance), describe);
+		}
+	}
+}
+
+FUZZ_CHECK(Compare_Matrix3, 0, 0) {
+	const size_t batch = 67;
+	Matrix3 a[batch], b[batch];
+	uint64_t mask[2];
+	for (size_t done = 0; done < fuzz.samples; done += batch) {
+		Tolerance tolerance = RandomTolerance(fuzz.rng);
+		Matrix3 reference;
+		for (int k = 0; k < 9; ++k) {
+			(&reference.m1)[k] = fuzz.rng.Float();
+		}
+		for (size_t i = 0; i < batch; ++i) {
+			Perturb(fuzz.rng, &reference.m1, &b[i].m1, 9);
+			a[i] = reference;
+		}
+		MathClasses::CompareWith(reference, b, batch, tolerance, mask);
+		for (size_t i = 0; i < batch; ++i) {
+			bool expected = true;
+			for (int k = 0; k < 9; ++k) {
+				expected &= Reference((&reference.m1)[k], (&b[i].m1)[k], tolerance);
+			}
+			auto describe = [&] { return Fuzz::Format("mode %d epsilon %.9g ulps %u, item %zu", static_cast<int>(tolerance.mode), tolerance.epsilon, tolerance.maxUlps, i); };
+			fuzz.CompareInt(expected, (mask[i / 64] >> (i % 64)) & 1, describe);
+			fuzz.CompareInt(expected, MathClasses::Near(a[i], b[i], tolerance), describe);
+		}
+	}
+}
@@ -0,0 +1,185 @@
+#include "Fuzz.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Fuzz {
+	namespace {
+		struct Entry {
+			std::string name;
+			Budget budget;
+			Check check;
+		};
+
+		std::vector<Entry>& Entries() {
+			static std::vector<Entry> entries;
+			return entries;
+		}
+
+		// FNV-1a, so seeds are the same on every platform
+		uint64_t HashName(const std::string& name) {
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (char c : name) {
+				hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+		float FromBits(uint32_t bits) {
+			float f;
+			std::memcpy(&f, &bits, sizeof(f));
+			return f;
+		}
+
+		// map float bit patterns onto a monotonic integer line so ulps can be subtracted
+		int64_t Ordered(float f) {
+			int32_t bits;
+			std::memcpy(&bits, &f, sizeof(bits));
+			return bits < 0 ? -static_cast<int64_t>(bits & 0x7fffffff) : static_cast<int64_t>(bits);
+		}
+	}
+
+	float Rng::Float() {
+		uint32_t kind = Bits() % 100;
+		uint32_t sign = Bits() & 0x80000000u;
+		if (kind < 50) {
+			return Uniform(-100.0f, 100.0f);
+		}
+		if (kind < 60) {
+			return Uniform(-1.0f, 1.0f);
+		}
+		if (kind < 70) {
+			// denormal: zero exponent, random mantissa
+			return FromBits(sign | (Bits() & 0x007fffffu));
+		}
+		if (kind < 80) {
+			// tiny normal values
+			return FromBits(sign | ((1 + Bits() % 20) << 23) | (Bits() & 0x007fffffu));
+		}
+		if (kind < 90) {
+			// huge values, exponent in the top twenty
+			return FromBits(sign | ((234 + Bits() % 20) << 23) | (Bits() & 0x007fffffu));
+		}
+		switch (kind % 5) {
+		case 0: return FromBits(sign);
+		case 1: return FromBits(sign | 0x7f800000u);
+		case 2: return std::numeric_limits<float>::quiet_NaN();
+		case 3: return FromBits(sign | 0x7f7fffffu);
+		default: return FromBits(Bits());
+		}
+	}
+
+	double UlpDistance(float expected, float actual) {
+		bool expectedNaN = std::isnan(expected), actualNaN = std::isnan(actual);
+		if (expectedNaN || actualNaN) {
+			return expectedNaN == actualNaN ? 0.0 : std::numeric_limits<double>::infinity();
+		}
+		if (std::isinf(expected) || std::isinf(actual)) {
+			return expected == actual ? 0.0 : std::numeric_limits<double>::infinity();
+		}
+		return static_cast<double>(std::llabs(Ordered(expected) - Ordered(actual)));
+	}
+
+	void Context::Compare(float expected, float actual, const std::function<std::string()>& describe) {
+		++compared;
+		double ulp = UlpDistance(expected, actual);
+		double relative = 0.0;
+		if (ulp > 0.0) {
+			double scale = std::fabs(static_cast<double>(expected));
+			relative = std::isfinite(ulp)
+				? std::fabs(static_cast<double>(actual) - expected) / (scale > 0.0 ? scale : 1.0)
+				: std::numeric_limits<double>::infinity();
+		}
+
+		bool withinUlp = ulp <= budget.maxUlp;
+		bool withinRelative = budget.maxRelative > 0 && relative <= budget.maxRelative;
+		if (!withinUlp && !withinRelative) {
+			++failures;
+		}
+		if (ulp > worstUlp) {
+			worstUlp = ulp;
+			worstRelative = std::max(worstRelative, relative);
+			worstInput = describe() + Format(" -> expected %.9g, got %.9g", expected, actual);
+		}
+		else if (relative > worstRelative) {
+			worstRelative = relative;
+		}
+	}
+
+	void Context::CompareInt(long long expected, long long actual, const std::function<std::string()>& describe) {
+		++compared;
+		double distance = static_cast<double>(std::llabs(expected - actual));
+		if (distance > budget.maxUlp) {
+			++failures;
+		}
+		if (distance > worstUlp) {
+			worstUlp = distance;
+			worstInput = describe() + Format(" -> expected %lld, got %lld", expected, actual);
+		}
+	}
+
+	void Register(const std::string& name, Budget budget, Check check) {
+		Entries().push_back({ name, budget, std::move(check) });
+	}
+
+	std::string Format(const char* format, ...) {
+		char buffer[512];
+		va_list args;
+		va_start(args, format);
+		std::vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		return buffer;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t samples = 2000000;
+	uint64_t seed = 1;
+	std::string filter;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+			samples = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		}
+		else {
+			std::printf("usage: %s [--samples n] [--seed n] [--filter text]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	int failed = 0;
+	std::printf("%-36s %12s %10s %12s %12s  %s\n", "Check", "Compared", "Worst ulp", "Worst rel", "Budget ulp", "Status");
+	for (const Fuzz::Entry& entry : Fuzz::Entries()) {
+		if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+			continue;
+		}
+
+		// every check gets its own stream so results do not depend on which others ran
+		Fuzz::Rng rng(seed ^ Fuzz::HashName(entry.name));
+		Fuzz::Context context(rng, samples);
+		context.budget = entry.budget;
+		entry.check(context);
+
+		bool ok = context.failures == 0;
+		failed += ok ? 0 : 1;
+		std::printf("%-36s %12zu %10.0f %12.3g %12.0f  %s\n", entry.name.c_str(), context.compared,
+			context.worstUlp, context.worstRelative, entry.budget.maxUlp, ok ? "ok" : "OVER BUDGET");
+		if (!context.worstInput.empty()) {
+			std::printf("    worst: %s\n", context.worstInput.c_str());
+		}
+		if (!ok) {
+			std::printf("    %zu of %zu results over budget\n", context.failures, context.compared);
+		}
+	}
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Fuzz
+{
+    // Small, fast and reproducible generator (xorshift64*)
+    class Rng
+    {
+    public:
+        explicit Rng(uint64_t seed) : state(seed ? seed : 0x9e3779b97f4a7c15ull) {}
+
+        uint64_t Next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545f4914f6cdd1dull;
+        }
+
+        uint32_t Bits() { return static_cast<uint32_t>(Next() >> 32); }
+
+        // Uniform in [lo, hi)
+        float Uniform(float lo, float hi) { return lo + (hi - lo) * ((Bits() >> 8) * (1.0f / 16777216.0f)); }
+
+        // Mix of ordinary values, tiny and denormal values, huge values, zeros, infinities and NaN
+        float Float();
+
+        // Ordinary values only, magnitude up to range
+        float Finite(float range) { return Uniform(-range, range); }
+
+    private:
+        uint64_t state;
+    };
+
+    // Largest error a fast path may show against its reference. A result passes when it is
+    // within maxUlp units in the last place or within maxRelative relative error.
+    struct Budget
+    {
+        double maxUlp = 0;
+        double maxRelative = 0;
+    };
+
+    // Distance in units in the last place; NaN against NaN is 0, NaN against a number is infinite
+    double UlpDistance(float expected, float actual);
+
+    class Context
+    {
+    public:
+        Context(Rng& rng, size_t samples) : rng(rng), samples(samples) {}
+
+        Rng& rng;
+        const size_t samples;   // number of inputs each check should try
+
+        // Compare one float result, describing the input for the report
+        void Compare(float expected, float actual, const std::function<std::string()>& describe);
+
+        // Compare integer results (colour channels, indices) where one step counts as one ulp
+        void CompareInt(long long expected, long long actual, const std::function<std::string()>& describe);
+
+        size_t compared = 0;
+        double worstUlp = 0;
+        double worstRelative = 0;
+        std::string worstInput;
+        size_t failures = 0;
+        Budget budget;
+    };
+
+    using Check = std::function<void(Context&)>;
+
+    void Register(const std::string& name, Budget budget, Check check);
+
+    struct Registrar
+    {
+        Registrar(const char* name, Budget budget, Check check) { Register(name, budget, std::move(check)); }
+    };
+
+    // printf-style formatting for input descriptions
+    std::string Format(const char* format, ...);
+}
+
+#define FUZZ_CHECK(name, maxUlp, maxRelative) \
+    static void name(Fuzz::Context& fuzz); \
+    static Fuzz::Registrar name##Registrar(#name, Fuzz::Budget{ maxUlp, maxRelative }, name); \
+    static void name(Fuzz::Context& fuzz)
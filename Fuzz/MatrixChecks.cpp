@@ -0,0 +1,406 @@
+#include "Fuzz.h"
+#include "MathHeaders/MatrixView.h"
+#include "MathHeaders/PaddedMatrix3.h"
+#include "MathHeaders/PrefixProduct.h"
+#include "MathHeaders/Skinning.h"
+#include "MathHeaders/SpriteBatch.h"
+#include "MathHeaders/VertexTransform.h"
+#include <cstring>
+#include <vector>
+
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Matrix3View;
+using MathClasses::Matrix4View;
+using MathClasses::MatrixOrder;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+
+namespace {
+	Matrix4 RandomMatrix4(Fuzz::Rng& rng) {
+		float m[16];
+		for (float& x : m) {
+			x = rng.Float();
+		}
+		return Matrix4(m);
+	}
+
+	Matrix3 RandomMatrix3(Fuzz::Rng& rng) {
+		float m[9];
+		for (float& x : m) {
+			x = rng.Float();
+		}
+		return Matrix3(m);
+	}
+
+	std::string DescribeMatrix(const float* m, int count) {
+		std::string text;
+		for (int i = 0; i < count; ++i) {
+			text += Fuzz::Format(i ? ", %.9g" : "%.9g", m[i]);
+		}
+		return text;
+	}
+}
+
+// views over row-major padded buffers multiply bit-identically to Matrix4
+FUZZ_CHECK(Matrix4View_Multiply, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += 20) {
+		Matrix4 a = RandomMatrix4(fuzz.rng), b = RandomMatrix4(fuzz.rng);
+		float rows[4 * 6];
+		MathClasses::Store(a, rows, MatrixOrder::RowMajor, 6);
+		Matrix4View view(rows, MatrixOrder::RowMajor, 6);
+
+		Matrix4 expected = a * b, actual = view * Matrix4View(b);
+		Vector4 v(fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Float());
+		Vector4 expectedV = a * v, actualV = view * v;
+		auto describe = [&] { return DescribeMatrix(&a.m1, 16) + " * " + DescribeMatrix(&b.m1, 16); };
+		const float* e = &expected.m1;
+		const float* r = &actual.m1;
+		for (int i = 0; i < 16; ++i) {
+			fuzz.Compare(e[i], r[i], describe);
+		}
+		fuzz.Compare(expectedV.x, actualV.x, describe);
+		fuzz.Compare(expectedV.y, actualV.y, describe);
+		fuzz.Compare(expectedV.z, actualV.z, describe);
+		fuzz.Compare(expectedV.w, actualV.w, describe);
+	}
+}
+
+FUZZ_CHECK(Matrix3View_Multiply, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += 9) {
+		Matrix3 a = RandomMatrix3(fuzz.rng), b = RandomMatrix3(fuzz.rng);
+		float rows[3 * 4];
+		MathClasses::Store(a, rows, MatrixOrder::RowMajor, 4);
+		Matrix3 expected = a * b, actual = Matrix3View(rows, MatrixOrder::RowMajor, 4) * Matrix3View(b);
+		auto describe = [&] { return DescribeMatrix(&a.m1, 9) + " * " + DescribeMatrix(&b.m1, 9); };
+		const float* e = &expected.m1;
+		const float* r = &actual.m1;
+		for (int i = 0; i < 9; ++i) {
+			fuzz.Compare(e[i], r[i], describe);
+		}
+	}
+}
+
+// in-place strided transforms match Matrix4 * Vector4 and leave the bytes around the attribute alone
+FUZZ_CHECK(VertexTransform_Strided, 0, 0) {
+	std::vector<unsigned char> buffer, before;
+	for (size_t done = 0; done < fuzz.samples;) {
+		size_t offset = fuzz.rng.Next() % 8;
+		size_t stride = offset + 12 + fuzz.rng.Next() % 9;
+		size_t count = 1 + fuzz.rng.Next() % 16;
+		bool point = (fuzz.rng.Next() & 1) != 0;
+		Matrix4 m = RandomMatrix4(fuzz.rng);
+		buffer.resize(stride * count);
+		for (unsigned char& b : buffer) {
+			b = static_cast<unsigned char>(fuzz.rng.Next());
+		}
+		for (size_t i = 0; i < count; ++i) {
+			float v[3] = { fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Float() };
+			std::memcpy(&buffer[i * stride + offset], v, sizeof(v));
+		}
+		before = buffer;
+		if (point) {
+			MathClasses::TransformPoints(m, buffer.data(), stride, offset, count);
+		} else {
+			MathClasses::TransformDirections(m, buffer.data(), stride, offset, count);
+		}
+
+		for (size_t i = 0; i < count; ++i, ++done) {
+			float v[3], r[3];
+			std::memcpy(v, &before[i * stride + offset], sizeof(v));
+			std::memcpy(r, &buffer[i * stride + offset], sizeof(r));
+			// directions never read the translation, so an inf or nan there must not leak in
+			Vector4 expected = point ? m * Vector4(v[0], v[1], v[2], 1.0f) :
+				Vector4(v[0] * m.m1 + v[1] * m.m5 + v[2] * m.m9, v[0] * m.m2 + v[1] * m.m6 + v[2] * m.m10,
+					v[0] * m.m3 + v[1] * m.m7 + v[2] * m.m11, 0.0f);
+			auto describe = [&] {
+				return DescribeMatrix(&m.m1, 16) + Fuzz::Format(" * (%.9g, %.9g, %.9g, %d)", v[0], v[1], v[2], point ? 1 : 0);
+			};
+			fuzz.Compare(expected.x, r[0], describe);
+			fuzz.Compare(expected.y, r[1], describe);
+			fuzz.Compare(expected.z, r[2], describe);
+			for (size_t b = 0; b < stride; ++b) {
+				if (b < offset || b >= offset + 12) {
+					fuzz.CompareInt(before[i * stride + b], buffer[i * stride + b], describe);
+				}
+			}
+		}
+	}
+}
+
+// Vector3 transforms against the Vector4 product they replace, singly and through the SoA batch
+// (directions are written out, w = 0 would let an inf or nan translation in)
+FUZZ_CHECK(Matrix4_TransformVector3, 0, 0) {
+	const size_t batch = 37;
+	float x[batch], y[batch], z[batch], ox[batch], oy[batch], oz[batch];
+	for (size_t done = 0; done < fuzz.samples; done += batch * 9) {
+		Matrix4 m = RandomMatrix4(fuzz.rng);
+		for (size_t i = 0; i < batch; ++i) {
+			x[i] = fuzz.rng.Float();
+			y[i] = fuzz.rng.Float();
+			z[i] = fuzz.rng.Float();
+		}
+		for (int mode = 0; mode < 3; ++mode) {
+			if (mode == 0) {
+				m.TransformPoints(x, y, z, ox, oy, oz, batch);
+			} else if (mode == 1) {
+				m.TransformDirections(x, y, z, ox, oy, oz, batch);
+			} else {
+				m.TransformPointsProjective(x, y, z, ox, oy, oz, batch);
+			}
+			for (size_t i = 0; i < batch; ++i) {
+				Vector3 v(x[i], y[i], z[i]);
+				Vector4 h = m * Vector4(v.x, v.y, v.z, 1.0f);
+				Vector3 expected = mode == 0 ? Vector3(h.x, h.y, h.z) :
+					mode == 1 ? Vector3(v.x * m.m1 + v.y * m.m5 + v.z * m.m9, v.x * m.m2 + v.y * m.m6 + v.z * m.m10,
+						v.x * m.m3 + v.y * m.m7 + v.z * m.m11) :
+					Vector3(h.x / h.w, h.y / h.w, h.z / h.w);
+				Vector3 single = mode == 0 ? m.TransformPoint(v) : mode == 1 ? m.TransformDirection(v) : m.TransformPointProjective(v);
+				auto describe = [&] {
+					return DescribeMatrix(&m.m1, 16) + Fuzz::Format(" mode %d (%.9g, %.9g, %.9g)", mode, v.x, v.y, v.z);
+				};
+				fuzz.Compare(expected.x, single.x, describe);
+				fuzz.Compare(expected.y, single.y, describe);
+				fuzz.Compare(expected.z, single.z, describe);
+				fuzz.Compare(expected.x, ox[i], describe);
+				fuzz.Compare(expected.y, oy[i], describe);
+				fuzz.Compare(expected.z, oz[i], describe);
+			}
+		}
+	}
+}
+
+// 2D affine transforms against the Matrix3 * Vector3(x, y, 1) they replace, all three entry points
+FUZZ_CHECK(Matrix3_TransformPoints2D, 0, 0) {
+	const size_t batch = 23;
+	float x[batch], y[batch], ox[batch], oy[batch];
+	Vector2 points[batch], out[batch];
+	for (size_t done = 0; done < fuzz.samples; done += batch * 6) {
+		Matrix3 m = RandomMatrix3(fuzz.rng);
+		for (size_t i = 0; i < batch; ++i) {
+			x[i] = fuzz.rng.Float();
+			y[i] = fuzz.rng.Float();
+			points[i] = Vector2(x[i], y[i]);
+		}
+		m.TransformPoints2D(x, y, ox, oy, batch);
+		m.TransformPoints2D(points, out, batch);
+		for (size_t i = 0; i < batch; ++i) {
+			Vector3 expected = m * Vector3(x[i], y[i], 1.0f);
+			Vector2 single = m.TransformPoint2D(points[i]);
+			auto describe = [&] { return DescribeMatrix(&m.m1, 9) + Fuzz::Format(" * (%.9g, %.9g)", x[i], y[i]); };
+			fuzz.Compare(expected.x, single.x, describe);
+			fuzz.Compare(expected.y, single.y, describe);
+			fuzz.Compare(expected.x, ox[i], describe);
+			fuzz.Compare(expected.y, oy[i], describe);
+			fuzz.Compare(expected.x, out[i].x, describe);
+			fuzz.Compare(expected.y, out[i].y, describe);
+		}
+	}
+}
+
+// batch inverse against TryInvert, bit for bit including which matrices are singular; products
+// with the original stay near identity for well-conditioned input
+FUZZ_CHECK(Matrix3_Invert, 0, 0) {
+	const size_t batch = 13;
+	Matrix3 in[batch], out[batch];
+	for (size_t done = 0; done < fuzz.samples; done += batch * 9) {
+		for (size_t i = 0; i < batch; ++i) {
+			in[i] = RandomMatrix3(fuzz.rng);
+		}
+		// a singular one now and then, rows 1 and 2 equal
+		if (fuzz.rng.Next() % 4 == 0) {
+			Matrix3& m = in[fuzz.rng.Next() % batch];
+			m.m4 = m.m1;
+			m.m5 = m.m2;
+			m.m6 = m.m3;
+		}
+		size_t singular = Matrix3::Invert(in, out, batch);
+		size_t expectedSingular = 0;
+		for (size_t i = 0; i < batch; ++i) {
+			Matrix3 expected;
+			if (!in[i].TryInvert(expected)) {
+				++expectedSingular;
+			}
+			auto describe = [&] { return DescribeMatrix(&in[i].m1, 9); };
+			const float* e = &expected.m1;
+			const float* r = &out[i].m1;
+			for (int k = 0; k < 9; ++k) {
+				fuzz.Compare(e[k], r[k], describe);
+			}
+		}
+		fuzz.CompareInt(static_cast<long long>(expectedSingular), static_cast<long long>(singular), [] { return std::string("singular count"); });
+	}
+}
+
+// the padded layout's SIMD operators against the packed Matrix3 ones
+FUZZ_CHECK(PaddedMatrix3_Operators, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += 21) {
+		Matrix3 a = RandomMatrix3(fuzz.rng), b = RandomMatrix3(fuzz.rng);
+		Vector3 v(fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Float());
+		MathClasses::PaddedMatrix3 pa(a), pb(b);
+		Matrix3 expected = a * b, actual = (pa * pb).ToMatrix3();
+		Matrix3 transposed = pa.Transposed().ToMatrix3(), expectedTransposed = a.Transposed();
+		Vector3 expectedV = a * v, actualV = pa * v;
+		auto describe = [&] { return DescribeMatrix(&a.m1, 9) + " * " + DescribeMatrix(&b.m1, 9); };
+		for (int i = 0; i < 9; ++i) {
+			fuzz.Compare((&expected.m1)[i], (&actual.m1)[i], describe);
+			fuzz.Compare((&expectedTransposed.m1)[i], (&transposed.m1)[i], describe);
+		}
+		fuzz.Compare(expectedV.x, actualV.x, describe);
+		fuzz.Compare(expectedV.y, actualV.y, describe);
+		fuzz.Compare(expectedV.z, actualV.z, describe);
+	}
+}
+
+// the batch Euler builders against the single ones, mostly ordinary angles with the odd value from
+// Float() (huge, infinite, NaN) pushing a group of four onto the scalar path
+FUZZ_CHECK(MakeEuler_Batch, 0, 0) {
+	const size_t batch = 11;
+	Vector3 euler[batch];
+	Matrix3 out3[batch];
+	Matrix4 out4[batch];
+	for (size_t done = 0; done < fuzz.samples; done += batch * 18) {
+		for (size_t i = 0; i < batch; ++i) {
+			euler[i] = Vector3(fuzz.rng.Finite(10.0f), fuzz.rng.Finite(10.0f), fuzz.rng.Finite(1000.0f));
+		}
+		if (fuzz.rng.Next() % 8 == 0) {
+			euler[fuzz.rng.Next() % batch].y = fuzz.rng.Float();
+		}
+		Matrix3::MakeEuler(euler, out3, batch);
+		Matrix4::MakeEuler(euler, out4, batch);
+		for (size_t i = 0; i < batch; ++i) {
+			Matrix3 expected3 = Matrix3::MakeEuler(euler[i]);
+			Matrix4 expected4 = Matrix4::MakeEuler(euler[i]);
+			auto describe = [&] { return Fuzz::Format("euler %.9g, %.9g, %.9g", euler[i].x, euler[i].y, euler[i].z); };
+			for (int k = 0; k < 9; ++k) {
+				fuzz.Compare((&expected3.m1)[k], (&out3[i].m1)[k], describe);
+			}
+			for (int k = 0; k < 16; ++k) {
+				fuzz.Compare((&expected4.m1)[k], (&out4[i].m1)[k], describe);
+			}
+		}
+	}
+}
+
+// Matrix3's closed-form Euler builder against multiplying out the three axis rotations
+FUZZ_CHECK(Matrix3_EulerClosedForm, 0, 0) {
+	for (size_t done = 0; done < fuzz.samples; done += 9) {
+		float pitch = fuzz.rng.Finite(10.0f), yaw = fuzz.rng.Finite(10.0f), roll = fuzz.rng.Finite(10.0f);
+		Matrix3 expected = Matrix3::MakeRotateZ(roll) * Matrix3::MakeRotateY(yaw) * Matrix3::MakeRotateX(pitch);
+		Matrix3 actual = Matrix3::MakeEuler(pitch, yaw, roll);
+		auto describe = [&] { return Fuzz::Format("euler %.9g, %.9g, %.9g", pitch, yaw, roll); };
+		for (int k = 0; k < 9; ++k) {
+			fuzz.Compare(Matrix3::RoundToMat3((&expected.m1)[k], 6), (&actual.m1)[k], describe);
+		}
+	}
+}
+
+// sprite quads against TransformPoint2D of each corner, tints and uvs copied through
+FUZZ_CHECK(SpriteBatch_Corners, 0, 0) {
+	const size_t batch = 7;
+	Matrix3 transforms[batch];
+	MathClasses::Colour tints[batch];
+	MathClasses::SpriteVertex out[batch * 4];
+	for (size_t done = 0; done < fuzz.samples; done += batch * 8) {
+		for (size_t i = 0; i < batch; ++i) {
+			transforms[i] = RandomMatrix3(fuzz.rng);
+			tints[i].colour = static_cast<uint32_t>(fuzz.rng.Next());
+		}
+		Vector2 size(fuzz.rng.Float(), fuzz.rng.Float());
+		MathClasses::BatchSprites(transforms, tints, batch, size, out);
+		float hx = size.x * 0.5f, hy = size.y * 0.5f;
+		const Vector2 corners[4] = { Vector2(-hx, -hy), Vector2(hx, -hy), Vector2(hx, hy), Vector2(-hx, hy) };
+		for (size_t i = 0; i < batch; ++i) {
+			auto describe = [&] { return DescribeMatrix(&transforms[i].m1, 9) + Fuzz::Format(" size %.9g, %.9g", size.x, size.y); };
+			for (int c = 0; c < 4; ++c) {
+				Vector2 expected = transforms[i].TransformPoint2D(corners[c]);
+				const MathClasses::SpriteVertex& v = out[i * 4 + c];
+				fuzz.Compare(expected.x, v.x, describe);
+				fuzz.Compare(expected.y, v.y, describe);
+				fuzz.CompareInt(tints[i].colour, v.colour.colour, describe);
+			}
+		}
+	}
+}
+
+// chains shorter than a block scan to exactly the serial operator* fold
+FUZZ_CHECK(PrefixProducts_SerialFold, 0, 0) {
+	const size_t chain = 9;
+	Matrix4 in4[chain], out4[chain];
+	Matrix3 in3[chain], out3[chain];
+	for (size_t done = 0; done < fuzz.samples; done += chain * 25) {
+		for (size_t i = 0; i < chain; ++i) {
+			in4[i] = RandomMatrix4(fuzz.rng);
+			in3[i] = RandomMatrix3(fuzz.rng);
+		}
+		MathClasses::PrefixProducts(in4, out4, chain);
+		MathClasses::PrefixProducts(in3, out3, chain);
+		Matrix4 running4 = in4[0];
+		Matrix3 running3 = in3[0];
+		for (size_t i = 0; i < chain; ++i) {
+			if (i > 0) {
+				running4 = running4 * in4[i];
+				running3 = running3 * in3[i];
+			}
+			auto describe = [&] { return Fuzz::Format("link %zu of ", i) + DescribeMatrix(&in4[i].m1, 16); };
+			for (int k = 0; k < 16; ++k) {
+				fuzz.Compare((&running4.m1)[k], (&out4[i].m1)[k], describe);
+			}
+			for (int k = 0; k < 9; ++k) {
+				fuzz.Compare((&running3.m1)[k], (&out3[i].m1)[k], describe);
+			}
+		}
+	}
+}
+
+// skinning four vertices at a time against one at a time (the scalar kernel), in both modes
+FUZZ_CHECK(Skin_Groups, 0, 0) {
+	const size_t count = 9, boneCount = 5;
+	Matrix4 palette[boneCount];
+	float in[6][count], out[6][count], single[6][count];
+	uint16_t bones[count * 4];
+	float weights[count * 4];
+	auto input = [&](size_t first) {
+		MathClasses::SkinInput streams;
+		streams.x = in[0] + first; streams.y = in[1] + first; streams.z = in[2] + first;
+		streams.nx = in[3] + first; streams.ny = in[4] + first; streams.nz = in[5] + first;
+		streams.bones = bones + first * 4;
+		streams.weights = weights + first * 4;
+		return streams;
+	};
+	auto output = [](float (*o)[count], size_t first) {
+		MathClasses::SkinOutput streams;
+		streams.x = o[0] + first; streams.y = o[1] + first; streams.z = o[2] + first;
+		streams.nx = o[3] + first; streams.ny = o[4] + first; streams.nz = o[5] + first;
+		return streams;
+	};
+	for (size_t done = 0; done < fuzz.samples; done += count * 12) {
+		for (Matrix4& m : palette) {
+			// mostly rigid bones, so dual quaternion mode sees the matrices it is meant for
+			m = fuzz.rng.Next() % 4 ? Matrix4::MakeEuler(fuzz.rng.Finite(4.0f), fuzz.rng.Finite(4.0f), fuzz.rng.Finite(4.0f)) *
+				Matrix4::MakeTranslation(fuzz.rng.Finite(10.0f), fuzz.rng.Finite(10.0f), fuzz.rng.Finite(10.0f)) : RandomMatrix4(fuzz.rng);
+		}
+		for (size_t i = 0; i < count; ++i) {
+			for (int c = 0; c < 6; ++c) {
+				in[c][i] = fuzz.rng.Next() % 16 ? fuzz.rng.Finite(100.0f) : fuzz.rng.Float();
+			}
+			for (int j = 0; j < 4; ++j) {
+				bones[i * 4 + j] = static_cast<uint16_t>(fuzz.rng.Next() % boneCount);
+				weights[i * 4 + j] = fuzz.rng.Uniform(0.0f, 1.0f);
+			}
+		}
+		for (MathClasses::SkinningMode mode : { MathClasses::SkinningMode::Linear, MathClasses::SkinningMode::DualQuaternion }) {
+			MathClasses::Skin(input(0), palette, boneCount, output(out, 0), count, mode);
+			for (size_t i = 0; i < count; ++i) {
+				MathClasses::Skin(input(i), palette, boneCount, output(single, i), 1, mode);
+			}
+			for (size_t i = 0; i < count; ++i) {
+				auto describe = [&] { return Fuzz::Format("vertex %.9g, %.9g, %.9g mode %d", in[0][i], in[1][i], in[2][i], static_cast<int>(mode)); };
+				for (int c = 0; c < 6; ++c) {
+					fuzz.Compare(single[c][i], out[c][i], describe);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#include "Fuzz.h"
+#include "MathHeaders/Format.h"
+#include "MathHeaders/Parse.h"
+#include <cstdio>
+#include <cstdlib>
+
+using MathClasses::Colour;
+using MathClasses::Matrix3;
+using MathClasses::Vector3;
+
+namespace {
+	float Reparse(const char* format, float value) {
+		char text[128];
+		std::snprintf(text, sizeof(text), format, value);
+		return std::strtof(text, nullptr);
+	}
+}
+
+// ToString's "%f" text read back by Parse against strtof of the same text
+FUZZ_CHECK(Parse_Vector3_ToString, 0, 0) {
+	for (size_t i = 0; i < fuzz.samples; ++i) {
+		Vector3 v(fuzz.rng.Float(), fuzz.rng.Float(), fuzz.rng.Float()), parsed;
+		std::string text = v.ToString();
+		auto describe = [&] { return text; };
+		if (!MathClasses::Parse::Value(text.data(), text.data() + text.size(), parsed)) {
+			fuzz.CompareInt(0, 1, describe);
+			continue;
+		}
+		fuzz.Compare(Reparse("%f", v.x), parsed.x, describe);
+		fuzz.Compare(Reparse("%f", v.y), parsed.y, describe);
+		fuzz.Compare(Reparse("%f", v.z), parsed.z, describe);
+	}
+}
+
+// nine significant digits identify a float exactly, so this round trip is lossless
+FUZZ_CHECK(Parse_Matrix3_RoundTrip, 0, 0) {
+	char text[512];
+	for (size_t i = 0; i < fuzz.samples; i += 9) {
+		float values[9];
+		for (float& x : values) {
+			x = fuzz.rng.Float();
+		}
+		Matrix3 m(values), parsed;
+		size_t length = m.FormatTo(text, sizeof(text), 9);
+		auto describe = [&] { return std::string(text); };
+		if (!MathClasses::Parse::Value(text, text + length, parsed)) {
+			fuzz.CompareInt(0, 1, describe);
+			continue;
+		}
+		const float* out = &parsed.m1;
+		for (int k = 0; k < 9; ++k) {
+			fuzz.Compare(values[k], out[k], describe);
+		}
+	}
+}
+
+FUZZ_CHECK(Parse_Colour_RoundTrip, 0, 0) {
+	char text[16];
+	for (size_t i = 0; i < fuzz.samples; ++i) {
+		Colour c, parsed;
+		c.colour = fuzz.rng.Bits();
+		size_t length = c.FormatTo(text, sizeof(text));
+		const char* end = MathClasses::Parse::Value(text, text + length, parsed);
+		fuzz.CompareInt(c.colour, end ? parsed.colour : ~c.colour, [&] { return std::string(text); });
+	}
+}
@@ -0,0 +1,222 @@
+#include "MathHeaders/Instrument.h"
+
+#if MATHCLASSES_INSTRUMENT
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if MATHCLASSES_INSTRUMENT_RDTSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace MathClasses {
+	namespace Instrument {
+		namespace {
+			const size_t CounterCount = static_cast<size_t>(Counter::Count);
+			// per thread cap so tracing a long benchmark cannot exhaust memory
+			const size_t MaxEventsPerThread = size_t(1) << 20;
+
+			struct Event {
+				Counter counter;
+				uint64_t start;
+				uint64_t end;
+			};
+
+			// counters are only written by their own thread; atomics keep reads from others race free
+			struct ThreadData {
+				std::atomic<uint64_t> counters[CounterCount];
+				std::vector<Event> events;
+				uint32_t id;
+
+				ThreadData();
+				~ThreadData();
+			};
+
+			struct Registry {
+				std::mutex mutex;
+				std::vector<ThreadData*> threads;
+				uint64_t retired[CounterCount] = {};
+				std::vector<std::pair<uint32_t, Event>> retiredEvents;
+				uint32_t nextId = 1;
+				std::atomic<bool> tracing{ false };
+			};
+
+			Registry& GetRegistry() {
+				// leaked so threads exiting during static destruction can still retire their data
+				static Registry* registry = new Registry();
+				return *registry;
+			}
+
+			ThreadData::ThreadData() {
+				for (auto& c : counters) {
+					c.store(0, std::memory_order_relaxed);
+				}
+				Registry& registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				id = registry.nextId++;
+				registry.threads.push_back(this);
+			}
+
+			ThreadData::~ThreadData() {
+				Registry& registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				for (size_t i = 0; i < CounterCount; ++i) {
+					registry.retired[i] += counters[i].load(std::memory_order_relaxed);
+				}
+				for (const Event& e : events) {
+					registry.retiredEvents.emplace_back(id, e);
+				}
+				for (size_t i = 0; i < registry.threads.size(); ++i) {
+					if (registry.threads[i] == this) {
+						registry.threads.erase(registry.threads.begin() + i);
+						break;
+					}
+				}
+			}
+
+			ThreadData& Local() {
+				thread_local ThreadData data;
+				return data;
+			}
+
+			uint64_t Now() {
+#if MATHCLASSES_INSTRUMENT_RDTSC
+				return __rdtsc();
+#else
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+			}
+
+			// timestamps per microsecond, measured against steady_clock for rdtsc
+			double TicksPerMicrosecond() {
+#if MATHCLASSES_INSTRUMENT_RDTSC
+				static double ticks = [] {
+					auto wallStart = std::chrono::steady_clock::now();
+					uint64_t tscStart = __rdtsc();
+					while (std::chrono::steady_clock::now() - wallStart < std::chrono::milliseconds(20)) {
+					}
+					double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wallStart).count();
+					return (__rdtsc() - tscStart) / us;
+				}();
+				return ticks;
+#else
+				return 1000.0;
+#endif
+			}
+		}
+
+		const char* Name(Counter counter) {
+			static const char* names[CounterCount] = {
+				"Matrix3::operator*(Matrix3)",
+				"Matrix3::operator*(Vector3)",
+				"Matrix4::operator*(Matrix4)",
+				"Matrix4::operator*(Vector4)",
+				"MakeEuler",
+				"Rotate",
+				"Trig",
+				"Normalise",
+				"ToString"
+			};
+			size_t i = static_cast<size_t>(counter);
+			return i < CounterCount ? names[i] : "Unknown";
+		}
+
+		void Add(Counter counter, uint64_t amount) {
+			std::atomic<uint64_t>& c = Local().counters[static_cast<size_t>(counter)];
+			c.store(c.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		uint64_t Total(Counter counter) {
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			size_t i = static_cast<size_t>(counter);
+			uint64_t total = registry.retired[i];
+			for (ThreadData* t : registry.threads) {
+				total += t->counters[i].load(std::memory_order_relaxed);
+			}
+			return total;
+		}
+
+		void Reset() {
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			for (size_t i = 0; i < CounterCount; ++i) {
+				registry.retired[i] = 0;
+				for (ThreadData* t : registry.threads) {
+					t->counters[i].store(0, std::memory_order_relaxed);
+				}
+			}
+			registry.retiredEvents.clear();
+			// other threads' event buffers are only touched by their owners
+			Local().events.clear();
+		}
+
+		void SetTracing(bool enabled) {
+			TicksPerMicrosecond();
+			GetRegistry().tracing.store(enabled, std::memory_order_relaxed);
+		}
+
+		bool WriteChromeTrace(const std::string& path) {
+			std::ofstream out(path);
+			if (!out) {
+				return false;
+			}
+
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			double perUs = TicksPerMicrosecond();
+
+			std::vector<std::pair<uint32_t, Event>> events = registry.retiredEvents;
+			for (ThreadData* t : registry.threads) {
+				for (const Event& e : t->events) {
+					events.emplace_back(t->id, e);
+				}
+			}
+			uint64_t origin = events.empty() ? 0 : events[0].second.start;
+			for (const auto& e : events) {
+				origin = e.second.start < origin ? e.second.start : origin;
+			}
+
+			out << "{\"traceEvents\":[\n";
+			bool first = true;
+			for (const auto& e : events) {
+				out << (first ? "" : ",\n") << "{\"name\":\"" << Name(e.second.counter)
+					<< "\",\"cat\":\"MathClasses\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.first
+					<< ",\"ts\":" << (e.second.start - origin) / perUs
+					<< ",\"dur\":" << (e.second.end - e.second.start) / perUs << "}";
+				first = false;
+			}
+
+			out << (first ? "" : ",\n") << "{\"name\":\"MathClasses counters\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":0,\"args\":{";
+			for (size_t i = 0; i < CounterCount; ++i) {
+				uint64_t total = registry.retired[i];
+				for (ThreadData* t : registry.threads) {
+					total += t->counters[i].load(std::memory_order_relaxed);
+				}
+				out << (i ? "," : "") << "\"" << Name(static_cast<Counter>(i)) << "\":" << total;
+			}
+			out << "}}\n]}\n";
+			return static_cast<bool>(out);
+		}
+
+		ScopedTimer::ScopedTimer(Counter counter) : counter(counter), start(Now()) {}
+
+		ScopedTimer::~ScopedTimer() {
+			if (GetRegistry().tracing.load(std::memory_order_relaxed)) {
+				std::vector<Event>& events = Local().events;
+				if (events.size() < MaxEventsPerThread) {
+					events.push_back({ counter, start, Now() });
+				}
+			}
+		}
+	}
+}
+#endif
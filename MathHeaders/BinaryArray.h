@@ -0,0 +1,223 @@
+#pragma once
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Colour.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace MathClasses
+{
+    // Binary container for arrays of the math types: a 64 byte header followed by the raw
+    // payload at an aligned offset, so a mapped file can be used in place. Multi-byte fields
+    // and payload are little-endian, the only byte order the readers accept.
+    //
+    // AoS stores the elements as they are in memory. SoA stores each 4 byte component as its
+    // own plane (x[count], y[count], ...), every plane starting on the alignment boundary.
+
+    enum class BinaryElement : uint32_t
+    {
+        Vector3 = 1,
+        Vector4 = 2,
+        Matrix3 = 3,
+        Matrix4 = 4,
+        Colour = 5
+    };
+
+    enum class BinaryLayout : uint32_t
+    {
+        AoS = 0,
+        SoA = 1
+    };
+
+    enum class BinaryStatus
+    {
+        Ok,
+        CannotOpen,
+        IoError,
+        BadMagic,
+        UnsupportedVersion,
+        Truncated,
+        BadHeader,
+        TypeMismatch,
+        ChecksumMismatch
+    };
+
+    // Readable name of a status for messages
+    const char* BinaryStatusName(BinaryStatus status);
+
+    struct BinaryHeader
+    {
+        static constexpr uint32_t Magic = 0x4143414d; // "MACA"
+        static constexpr uint16_t CurrentVersion = 1;
+        static constexpr uint32_t FlagChecksum = 1;
+
+        uint32_t magic;
+        uint16_t version;
+        uint16_t headerSize;    // sizeof(BinaryHeader), lets later versions grow it
+        uint32_t element;       // BinaryElement
+        uint32_t layout;        // BinaryLayout
+        uint32_t elementSize;   // bytes per element
+        uint32_t alignment;     // payload and SoA plane alignment, a power of two
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t payloadOffset; // from the start of the file
+        uint64_t payloadSize;   // including padding between SoA planes
+        uint64_t checksum;      // Checksum64 over the Checksum64 of each plane, when FlagChecksum is set
+    };
+    static_assert(sizeof(BinaryHeader) == 64, "BinaryHeader must stay 64 bytes");
+
+    // Element type of each supported type
+    template<typename T> struct BinaryTraits;
+    template<> struct BinaryTraits<Vector3> { static constexpr BinaryElement element = BinaryElement::Vector3; };
+    template<> struct BinaryTraits<Vector4> { static constexpr BinaryElement element = BinaryElement::Vector4; };
+    template<> struct BinaryTraits<Matrix3> { static constexpr BinaryElement element = BinaryElement::Matrix3; };
+    template<> struct BinaryTraits<Matrix4> { static constexpr BinaryElement element = BinaryElement::Matrix4; };
+    template<> struct BinaryTraits<Colour> { static constexpr BinaryElement element = BinaryElement::Colour; };
+
+    // Streaming 64-bit hash (four 64-bit lanes in the style of xxHash64, not compatible with it)
+    class Checksum64
+    {
+    public:
+        Checksum64();
+        void Update(const void* data, size_t size);
+        uint64_t Final() const;
+
+    private:
+        uint64_t lanes[4];
+        uint8_t pending[32];
+        size_t pendingSize;
+        uint64_t total;
+    };
+
+    // Read-only view over a container held in memory (a mapped file or a loaded buffer)
+    class BinaryView
+    {
+    public:
+        BinaryView();
+
+        // Validate the header and payload bounds; data must stay alive while the view is used
+        BinaryStatus Open(const void* data, size_t size);
+
+        const BinaryHeader& Header() const { return header; }
+        size_t Count() const { return static_cast<size_t>(header.count); }
+        BinaryLayout Layout() const { return static_cast<BinaryLayout>(header.layout); }
+
+        // Recompute the checksum; Ok when it matches or the file has none
+        BinaryStatus Verify() const;
+
+        // AoS elements in place, or nullptr when the type or layout differs
+        template<typename T>
+        const T* Elements() const
+        {
+            return static_cast<const T*>(ElementsOf(BinaryTraits<T>::element, sizeof(T)));
+        }
+
+        // One SoA component plane (component < elementSize / 4), nullptr if out of range or AoS
+        const float* Plane(size_t component) const;
+
+        // Copy the elements out whichever layout was stored
+        template<typename T>
+        BinaryStatus CopyTo(T* out) const
+        {
+            return CopyOut(BinaryTraits<T>::element, sizeof(T), out);
+        }
+
+    private:
+        const void* ElementsOf(BinaryElement element, size_t elementSize) const;
+        BinaryStatus CopyOut(BinaryElement element, size_t elementSize, void* out) const;
+        size_t PlaneStride() const;
+
+        const uint8_t* base;
+        BinaryHeader header;
+    };
+
+    // Read-only memory mapping of a whole file
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        BinaryStatus Open(const std::string& path);
+        void Close();
+
+        const void* Data() const { return data; }
+        size_t Size() const { return size; }
+
+    private:
+        const void* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* file = nullptr;
+        void* mapping = nullptr;
+#endif
+    };
+
+    // Streaming writer. AoS output can be appended without knowing the final count; SoA needs
+    // the count up front so each plane can be written in place. The header is completed by
+    // Finish (also called by the destructor).
+    class BinaryWriter
+    {
+    public:
+        static constexpr size_t UnknownCount = ~size_t(0);
+
+        BinaryWriter() = default;
+        ~BinaryWriter();
+        BinaryWriter(const BinaryWriter&) = delete;
+        BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+        template<typename T>
+        BinaryStatus Open(const std::string& path, BinaryLayout layout = BinaryLayout::AoS, size_t count = UnknownCount,
+            bool checksum = true, uint32_t alignment = 64)
+        {
+            return OpenRaw(path, BinaryTraits<T>::element, sizeof(T), layout, count, checksum, alignment);
+        }
+
+        template<typename T>
+        BinaryStatus Append(const T* items, size_t count)
+        {
+            if (static_cast<uint32_t>(BinaryTraits<T>::element) != header.element)
+            {
+                return BinaryStatus::TypeMismatch;
+            }
+            return AppendRaw(items, count);
+        }
+
+        BinaryStatus Finish();
+
+    private:
+        BinaryStatus OpenRaw(const std::string& path, BinaryElement element, size_t elementSize, BinaryLayout layout,
+            size_t count, bool checksum, uint32_t alignment);
+        BinaryStatus AppendRaw(const void* items, size_t count);
+        BinaryStatus Fail(BinaryStatus status);
+
+        std::FILE* file = nullptr;
+        BinaryHeader header = {};
+        uint64_t written = 0;
+        std::vector<Checksum64> planeHashes;
+        std::vector<float> scratch;
+    };
+
+    // One-shot write of a whole array
+    template<typename T>
+    BinaryStatus WriteBinary(const std::string& path, const T* items, size_t count,
+        BinaryLayout layout = BinaryLayout::AoS, bool checksum = true)
+    {
+        BinaryWriter writer;
+        BinaryStatus status = writer.Open<T>(path, layout, count, checksum);
+        if (status == BinaryStatus::Ok)
+        {
+            status = writer.Append(items, count);
+        }
+        BinaryStatus finished = writer.Finish();
+        return status == BinaryStatus::Ok ? finished : status;
+    }
+}
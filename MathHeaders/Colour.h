@@ -1,5 +1,7 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace MathClasses
 {
@@ -30,7 +32,33 @@ namespace MathClasses
         bool operator==(const Colour& other) const;
         bool operator!=(const Colour& other) const;
 
+        // Saturating per-channel arithmetic, results are clamped to 0..255
+        Colour operator+(const Colour& other) const;
+        Colour& operator+=(const Colour& other);
+        Colour operator-(const Colour& other) const;
+        Colour& operator-=(const Colour& other);
+        Colour operator*(float scalar) const;
+        Colour& operator*=(float scalar);
+
+        // Per-channel interpolation, t is clamped to [0, 1] and quantised to 1/256 steps
+        static Colour Lerp(const Colour& a, const Colour& b, float t);
+
+        // "#RRGGBBAA"
+        std::string ToString() const;
+        // Writes ToString's text into buffer without allocating and returns its length (9)
+        size_t FormatTo(char* buffer, size_t size) const;
+
         // Colour data
         uint32_t colour; 
     };
+
+    // Batch operations over arrays, mapped onto packed byte SSE2 instructions where available
+    void AddSaturate(const Colour* a, const Colour* b, Colour* out, size_t count);
+    void SubtractSaturate(const Colour* a, const Colour* b, Colour* out, size_t count);
+    // Rounded per-channel average of a and b
+    void Average(const Colour* a, const Colour* b, Colour* out, size_t count);
+    // out[i] = Lerp(a[i], b[i], t)
+    void CrossFade(const Colour* a, const Colour* b, Colour* out, size_t count, float t);
+    // Fill out with a gradient running from 'from' at the first entry to 'to' at the last
+    void FillGradient(Colour* out, size_t count, const Colour& from, const Colour& to);
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include "Colour.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MathClasses
+{
+    struct ColourHistogram
+    {
+        // Constructor clears all bins
+        ColourHistogram();
+
+        // Reset every bin to zero
+        void Clear();
+
+        // Count a single colour
+        void Add(const Colour& c);
+
+        // Accumulate the bins of another histogram into this one
+        void Merge(const ColourHistogram& other);
+
+        // Total number of colours counted
+        uint64_t Total() const;
+
+        // Build a histogram over a pixel array. Each worker thread fills its own
+        // private bins which are merged at the end (0 = use all workers)
+        static ColourHistogram Build(const Colour* pixels, size_t count, unsigned threadCount = 0);
+
+        // Per-channel bin counts, indexed by channel value
+        uint64_t red[256];
+        uint64_t green[256];
+        uint64_t blue[256];
+        uint64_t alpha[256];
+    };
+
+    // Build a palette of at most paletteSize colours using median cut
+    std::vector<Colour> MakePaletteMedianCut(const Colour* pixels, size_t count, size_t paletteSize = 256);
+
+    // Index of the palette entry closest to c (squared RGBA distance, first match wins ties)
+    size_t FindNearestPaletteIndex(const Colour& c, const Colour* palette, size_t paletteSize);
+
+    // Write the nearest palette index of every pixel into indices (paletteSize must be <= 256)
+    void MapToPalette(const Colour* pixels, size_t count, const Colour* palette, size_t paletteSize, uint8_t* indices);
+}
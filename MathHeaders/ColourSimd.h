@@ -0,0 +1,75 @@
+#pragma once
+#include "Colour.h"
+#include "SimdConfig.h"
+
+namespace MathClasses
+{
+    namespace Simd
+    {
+        // Scalar min/max with the NaN behaviour of minps/maxps (the second operand wins),
+        // so scalar tails and fallbacks agree with the SSE2 paths on every input
+        inline float MinPs(float a, float b)
+        {
+            return a < b ? a : b;
+        }
+
+        inline float MaxPs(float a, float b)
+        {
+            return a > b ? a : b;
+        }
+
+        // Clamp to [0, 1] and round to 0..255; NaN becomes 0
+        inline uint8_t ToByte(float value)
+        {
+            value = MinPs(MaxPs(value, 0.0f), 1.0f);
+            return static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+    }
+}
+
+#if MATHCLASSES_SSE2
+namespace MathClasses
+{
+    namespace Simd
+    {
+        // Four colours split into one float register per channel, scaled to [0, 1]
+        struct Channels4
+        {
+            __m128 r, g, b, a;
+        };
+
+        inline Channels4 Unpack4(const Colour* in)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            __m128i mask = _mm_set1_epi32(0xff);
+            __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+            return {
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(v, 24)), scale),
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask)), scale),
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask)), scale),
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(v, mask)), scale)
+            };
+        }
+
+        // Clamp to [0, 1] and round to 0..255, matching static_cast<uint8_t>(v * 255 + 0.5f)
+        inline __m128i ToBytes4(__m128 value)
+        {
+            value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+        }
+
+        inline void Pack4(__m128 r, __m128 g, __m128 b, __m128 a, Colour* out)
+        {
+            __m128i v = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(ToBytes4(r), 24), _mm_slli_epi32(ToBytes4(g), 16)),
+                _mm_or_si128(_mm_slli_epi32(ToBytes4(b), 8), ToBytes4(a)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+        }
+
+        inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+    }
+}
+#endif
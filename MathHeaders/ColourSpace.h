@@ -0,0 +1,29 @@
+#pragma once
+#include "Colour.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    // Hue is in degrees [0, 360), every other channel is in [0, 1]
+    struct ColourHSV
+    {
+        float h, s, v, a;
+    };
+
+    struct ColourHSL
+    {
+        float h, s, l, a;
+    };
+
+    // Single colour conversions
+    ColourHSV ToHSV(const Colour& c);
+    ColourHSL ToHSL(const Colour& c);
+    Colour FromHSV(const ColourHSV& hsv);
+    Colour FromHSL(const ColourHSL& hsl);
+
+    // Batch conversions over arrays, branch-free and four pixels at a time where SSE2 is available
+    void ToHSV(const Colour* in, ColourHSV* out, size_t count);
+    void ToHSL(const Colour* in, ColourHSL* out, size_t count);
+    void FromHSV(const ColourHSV* in, Colour* out, size_t count);
+    void FromHSL(const ColourHSL* in, Colour* out, size_t count);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MathClasses
+{
+    // How two floats are judged equal. Bitwise equal values (but not NaN) always are, so infinities
+    // match themselves in every mode; NaN never matches anything.
+    enum class CompareMode
+    {
+        Absolute,   // |a - b| <= epsilon
+        Relative,   // |a - b| <= epsilon * max(|a|, |b|)
+        Ulp         // at most maxUlps representable floats apart, +0 and -0 being the same
+    };
+
+    struct Tolerance
+    {
+        // Ulp counts are capped at MaxUlps, beyond which the distance no longer fits 32-bit lanes
+        static constexpr uint32_t MaxUlps = (1u << 24) - 1;
+
+        CompareMode mode;
+        float epsilon;
+        uint32_t maxUlps;
+
+        static Tolerance Absolute(float epsilon = 1e-5f) { return { CompareMode::Absolute, epsilon, 0 }; }
+        static Tolerance Relative(float epsilon = 1e-5f) { return { CompareMode::Relative, epsilon, 0 }; }
+        static Tolerance Ulps(uint32_t maxUlps = 4) { return { CompareMode::Ulp, 0.0f, maxUlps }; }
+    };
+
+    // All elements within the tolerance
+    bool Near(float a, float b, const Tolerance& tolerance);
+    bool Near(const Matrix3& a, const Matrix3& b, const Tolerance& tolerance);
+    bool Near(const Matrix4& a, const Matrix4& b, const Tolerance& tolerance);
+
+    // Batch comparisons, SSE2 where available and without per-element branches. Bit i % 64 of
+    // mask[i / 64] is set when pair i is near; mask needs (count + 63) / 64 words and is fully
+    // overwritten. Both return the number of set bits.
+
+    // a[i] against b[i]
+    size_t Compare(const Matrix3* a, const Matrix3* b, size_t count, const Tolerance& tolerance, uint64_t* mask);
+    size_t Compare(const Matrix4* a, const Matrix4* b, size_t count, const Tolerance& tolerance, uint64_t* mask);
+
+    // Every item against one reference, for deduplication
+    size_t CompareWith(const Matrix3& reference, const Matrix3* items, size_t count, const Tolerance& tolerance, uint64_t* mask);
+    size_t CompareWith(const Matrix4& reference, const Matrix4* items, size_t count, const Tolerance& tolerance, uint64_t* mask);
+}
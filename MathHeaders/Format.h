@@ -0,0 +1,136 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <string>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+namespace MathClasses
+{
+    namespace Format
+    {
+        // Bounded writer behind the FormatTo members. Output past the end of the buffer is
+        // dropped but still counted, so Finish returns the full length like snprintf does.
+        class Writer
+        {
+        public:
+            Writer(char* buffer, size_t size);
+
+            void Put(char c);
+            void Put(const char* text);
+            // Precision is clamped to [0, 50]
+            void Put(float value, std::chars_format format, int precision);
+            // Two uppercase hex digits
+            void PutHex(unsigned value);
+
+            // NUL terminates (when size > 0) and returns the untruncated length
+            size_t Finish();
+
+        private:
+            char* out;
+            char* end;
+            size_t length;
+        };
+
+        // std::string from any FormatTo, heap use is limited to the returned string
+        template<typename T, typename... Args>
+        std::string ToString(const T& value, Args... args)
+        {
+            char buffer[256];
+            size_t length = value.FormatTo(buffer, sizeof(buffer), args...);
+            if (length < sizeof(buffer))
+            {
+                return std::string(buffer, length);
+            }
+            std::string text(length, '\0');
+            value.FormatTo(&text[0], length + 1, args...);
+            return text;
+        }
+    }
+}
+
+#if defined(__cpp_lib_format)
+#include <algorithm>
+#include <format>
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Colour.h"
+
+namespace MathClasses
+{
+    namespace Format
+    {
+        // Accepts "{}" and "{:.N}", N is passed to FormatTo as the precision
+        template<typename T>
+        struct Formatter
+        {
+            int precision = -1;
+
+            constexpr auto parse(std::format_parse_context& context)
+            {
+                auto it = context.begin();
+                if (it != context.end() && *it == '.')
+                {
+                    precision = 0;
+                    for (++it; it != context.end() && *it >= '0' && *it <= '9'; ++it)
+                    {
+                        precision = precision * 10 + (*it - '0');
+                    }
+                }
+                if (it != context.end() && *it != '}')
+                {
+                    throw std::format_error("MathClasses types only take a precision");
+                }
+                return it;
+            }
+
+            template<typename Context>
+            auto format(const T& value, Context& context) const
+            {
+                char buffer[1024];
+                size_t length = value.FormatTo(buffer, sizeof(buffer), precision);
+                if (length < sizeof(buffer))
+                {
+                    return std::copy(buffer, buffer + length, context.out());
+                }
+                std::string text = ToString(value, precision);
+                return std::copy(text.begin(), text.end(), context.out());
+            }
+        };
+    }
+}
+
+template<> struct std::formatter<MathClasses::Vector2> : MathClasses::Format::Formatter<MathClasses::Vector2> {};
+template<> struct std::formatter<MathClasses::Vector3> : MathClasses::Format::Formatter<MathClasses::Vector3> {};
+template<> struct std::formatter<MathClasses::Vector4> : MathClasses::Format::Formatter<MathClasses::Vector4> {};
+template<> struct std::formatter<MathClasses::Matrix3> : MathClasses::Format::Formatter<MathClasses::Matrix3> {};
+template<> struct std::formatter<MathClasses::Matrix4> : MathClasses::Format::Formatter<MathClasses::Matrix4> {};
+
+template<> struct std::formatter<MathClasses::Colour>
+{
+    constexpr auto parse(std::format_parse_context& context)
+    {
+        auto it = context.begin();
+        if (it != context.end() && *it != '}')
+        {
+            throw std::format_error("Colour takes no format options");
+        }
+        return it;
+    }
+
+    template<typename Context>
+    auto format(const MathClasses::Colour& value, Context& context) const
+    {
+        char buffer[16];
+        size_t length = value.FormatTo(buffer, sizeof(buffer));
+        return std::copy(buffer, buffer + length, context.out());
+    }
+};
+#endif
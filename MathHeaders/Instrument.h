@@ -0,0 +1,85 @@
+#pragma once
+
+// Hot-path instrumentation, compiled in only when MATHCLASSES_INSTRUMENT is defined to 1.
+// MATHCLASSES_INSTRUMENT_TIMERS additionally wraps the instrumented calls in scoped timers
+// (steady_clock, or rdtsc with MATHCLASSES_INSTRUMENT_RDTSC) that can be exported as a
+// Chrome trace. With MATHCLASSES_INSTRUMENT undefined every macro below expands to nothing.
+
+#ifndef MATHCLASSES_INSTRUMENT
+#define MATHCLASSES_INSTRUMENT 0
+#endif
+
+#if MATHCLASSES_INSTRUMENT
+#include <cstdint>
+#include <string>
+
+namespace MathClasses
+{
+    namespace Instrument
+    {
+        enum class Counter
+        {
+            Matrix3Multiply,
+            Matrix3MultiplyVector,
+            Matrix4Multiply,
+            Matrix4MultiplyVector,
+            MakeEuler,
+            Rotate,
+            Trig,
+            Normalise,
+            ToString,
+            Count
+        };
+
+        // Display name of a counter, also used for its trace events
+        const char* Name(Counter counter);
+
+        // Add to the calling thread's counter
+        void Add(Counter counter, uint64_t amount);
+
+        // Sum of a counter over every thread, including threads that have exited
+        uint64_t Total(Counter counter);
+
+        // Zero every counter and drop the trace events of the calling thread and of exited threads
+        void Reset();
+
+        // Start or stop recording timer events (off by default, capped per thread)
+        void SetTracing(bool enabled);
+
+        // Write recorded events and counter totals in Chrome trace JSON (chrome://tracing, Perfetto)
+        bool WriteChromeTrace(const std::string& path);
+
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(Counter counter);
+            ~ScopedTimer();
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Counter counter;
+            uint64_t start;
+        };
+    }
+}
+
+#define MATHCLASSES_COUNT_N(counter, n) ::MathClasses::Instrument::Add(::MathClasses::Instrument::Counter::counter, (n))
+#define MATHCLASSES_COUNT(counter) MATHCLASSES_COUNT_N(counter, 1)
+
+#if MATHCLASSES_INSTRUMENT_TIMERS
+#define MATHCLASSES_SCOPE_NAME2(a, b) a##b
+#define MATHCLASSES_SCOPE_NAME(a, b) MATHCLASSES_SCOPE_NAME2(a, b)
+#define MATHCLASSES_SCOPE(counter) \
+    MATHCLASSES_COUNT(counter); \
+    ::MathClasses::Instrument::ScopedTimer MATHCLASSES_SCOPE_NAME(mathClassesTimer, __LINE__)(::MathClasses::Instrument::Counter::counter)
+#else
+#define MATHCLASSES_SCOPE(counter) MATHCLASSES_COUNT(counter)
+#endif
+
+#else
+#define MATHCLASSES_COUNT_N(counter, n) ((void)0)
+#define MATHCLASSES_COUNT(counter) ((void)0)
+#define MATHCLASSES_SCOPE(counter) ((void)0)
+#endif
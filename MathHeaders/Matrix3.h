@@ -1,5 +1,7 @@
 #pragma once
+#include "Vector2.h"
 #include "Vector3.h"
+#include <cstddef>
 #include <cmath>
 
 namespace MathClasses
@@ -25,6 +27,14 @@ namespace MathClasses
         // Matrix-vector multiplication
         Vector3 operator*(const Vector3& rhs) const;
 
+        // 2D affine transform of a point, the translation being m7, m8 as SetTranslation stores it.
+        // The bottom row is taken to be (0, 0, 1), so this is 6 multiply-adds rather than 9.
+        Vector2 TransformPoint2D(const Vector2& p) const;
+
+        // The same over SoA x/y arrays or a Vector2 array; the outputs may be the inputs
+        void TransformPoints2D(const float* x, const float* y, float* outX, float* outY, size_t count) const;
+        void TransformPoints2D(const Vector2* points, Vector2* out, size_t count) const;
+
         // Set methods
         void Set(const Matrix3& m);
         void Set(float m1, float m2, float m3, float m4, float m5, float m6, float m7, float m8, float m9);
@@ -51,6 +61,9 @@ namespace MathClasses
 
         // ToString method
         std::string ToString() const;
+        // Writes ToString's text into buffer without allocating and returns its full length, like
+        // snprintf. precision is significant digits, -1 keeps ToString's 6.
+        size_t FormatTo(char* buffer, size_t size, int precision = -1) const;
 
         // Static factory methods
         static Matrix3 MakeIdentity();
@@ -62,6 +75,8 @@ namespace MathClasses
         static Matrix3 MakeRotateZ(float radians);
         static Matrix3 MakeEuler(float pitch, float yaw, float roll);
         static Matrix3 MakeEuler(const Vector3& euler);
+        // MakeEuler over an array of (pitch, yaw, roll), four at a time with SSE2; same results
+        static void MakeEuler(const Vector3* euler, Matrix3* out, size_t count);
         static Matrix3 MakeScale(float x, float y);
         static Matrix3 MakeScale(float x, float y, float z);
         static Matrix3 MakeScale(const Vector3& scale);
@@ -69,6 +84,22 @@ namespace MathClasses
         // Transpose method
         Matrix3 Transposed() const;
 
+        // Determinant and inverse. A matrix is singular when 1 / Determinant() is not finite;
+        // TryInvert then returns false and leaves out alone, Inverted returns a zero matrix.
+        float Determinant() const;
+        Matrix3 Inverted() const;
+        bool TryInvert(Matrix3& out) const;
+
+        // Fast inverse of a 2D affine transform (bottom row 0 0 1, as MakeTranslation(x, y),
+        // MakeRotateZ and MakeScale(x, y) build): the 2x2 part is inverted and the translation
+        // taken back through it. Other matrices need Inverted.
+        bool IsAffine2D() const;
+        Matrix3 InvertedAffine2D() const;
+
+        // Inverts count matrices, four at a time with SSE2; out may be in. Singular ones become
+        // zero matrices, their number is returned.
+        static size_t Invert(const Matrix3* in, Matrix3* out, size_t count);
+
         // Equality operator
         bool operator==(const Matrix3& rhs) const;
 
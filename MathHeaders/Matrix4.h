@@ -1,6 +1,7 @@
 #pragma once
 #include "Vector4.h"
 #include "Vector3.h"
+#include <cstddef>
 #include <string>
 #include <cmath>
 #include <sstream>
@@ -28,6 +29,20 @@ namespace MathClasses
         Matrix4 operator*(const Matrix4& rhs) const;
         Vector4 operator*(const Vector4& rhs) const;
 
+        // Vector3 transforms without building a Vector4: points take the translation (w = 1),
+        // directions ignore it (w = 0), projective points are divided by the resulting w
+        Vector3 TransformPoint(const Vector3& p) const;
+        Vector3 TransformDirection(const Vector3& d) const;
+        Vector3 TransformPointProjective(const Vector3& p) const;
+
+        // The same over SoA arrays of count elements; the outputs may be the inputs
+        void TransformPoints(const float* x, const float* y, const float* z,
+            float* outX, float* outY, float* outZ, size_t count) const;
+        void TransformDirections(const float* x, const float* y, const float* z,
+            float* outX, float* outY, float* outZ, size_t count) const;
+        void TransformPointsProjective(const float* x, const float* y, const float* z,
+            float* outX, float* outY, float* outZ, size_t count) const;
+
         // Matrix addition and subtraction
         bool operator==(const Matrix4& rhs) const;
         bool operator!=(const Matrix4& rhs) const;
@@ -71,6 +86,8 @@ namespace MathClasses
         static Matrix4 MakeRotateZ(float radians);
         static Matrix4 MakeEuler(float pitch, float yaw, float roll);
         static Matrix4 MakeEuler(const Vector3& euler);
+        // MakeEuler over an array of (pitch, yaw, roll), four at a time with SSE2; same results
+        static void MakeEuler(const Vector3* euler, Matrix4* out, size_t count);
         static Matrix4 MakeScale(float x, float y, float z);
         static Matrix4 MakeScale(const Vector3& v);
 
@@ -79,6 +96,9 @@ namespace MathClasses
 
          // ToString method
         std::string ToString() const;
+        // Writes ToString's text into buffer without allocating and returns its full length, like
+        // snprintf. precision is the number of decimals, -1 keeps ToString's 2.
+        size_t FormatTo(char* buffer, size_t size, int precision = -1) const;
     };
 
     std::ostream& operator<<(std::ostream& os, const Matrix4& m);
@@ -0,0 +1,131 @@
+#pragma once
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    // Element order of an external float buffer. ColumnMajor is the order of m1..m16 (and
+    // m1..m9): each run of 4 (or 3) floats is one column, translation sits in the last one.
+    // RowMajor is its transpose, as HLSL row_major or a C float[4][4] of rows holds it.
+    enum class MatrixOrder
+    {
+        ColumnMajor,
+        RowMajor
+    };
+
+    // Non-owning read-only view of 3 floats, stride floats apart (3 planes of an SoA array use
+    // the plane length as the stride)
+    struct Vector3View
+    {
+        const float* data;
+        size_t stride;
+
+        Vector3View(const float* data, size_t stride = 1) : data(data), stride(stride) {}
+        Vector3View(const Vector3& v) : data(&v.x), stride(1) {}
+
+        float X() const { return data[0]; }
+        float Y() const { return data[stride]; }
+        float Z() const { return data[2 * stride]; }
+
+        Vector3 ToVector3() const { return Vector3(X(), Y(), Z()); }
+
+        float Dot(Vector3View other) const;
+        Vector3 Cross(Vector3View other) const;
+        float Magnitude() const;
+        bool Equals(Vector3View other, float epsilon = 1e-5f) const;
+    };
+
+    struct Vector4View
+    {
+        const float* data;
+        size_t stride;
+
+        Vector4View(const float* data, size_t stride = 1) : data(data), stride(stride) {}
+        Vector4View(const Vector4& v) : data(&v.x), stride(1) {}
+
+        float X() const { return data[0]; }
+        float Y() const { return data[stride]; }
+        float Z() const { return data[2 * stride]; }
+        float W() const { return data[3 * stride]; }
+
+        Vector4 ToVector4() const { return Vector4(X(), Y(), Z(), W()); }
+
+        float Dot(Vector4View other) const;
+        float Magnitude() const;
+        bool Equals(Vector4View other, float epsilon = 1e-5f) const;
+    };
+
+    // Non-owning read-only view of a 4x4 matrix. stride is the distance in floats between the
+    // starts of consecutive columns (ColumnMajor) or rows (RowMajor), at least 4.
+    struct Matrix4View
+    {
+        const float* data;
+        MatrixOrder order;
+        size_t stride;
+
+        Matrix4View(const float* data, MatrixOrder order = MatrixOrder::ColumnMajor, size_t stride = 4)
+            : data(data), order(order), stride(stride) {}
+        Matrix4View(const Matrix4& m) : data(&m.m1), order(MatrixOrder::ColumnMajor), stride(4) {}
+
+        // Element in column-vector terms: At(row, 3) is the translation
+        float At(int row, int column) const
+        {
+            return order == MatrixOrder::ColumnMajor ? data[column * stride + row] : data[row * stride + column];
+        }
+
+        // The same floats read the other way round
+        Matrix4View Transposed() const
+        {
+            return Matrix4View(data, order == MatrixOrder::ColumnMajor ? MatrixOrder::RowMajor : MatrixOrder::ColumnMajor, stride);
+        }
+
+        Matrix4 ToMatrix4() const;
+
+        // Same results as the Matrix4 operators
+        Matrix4 operator*(const Matrix4View& rhs) const;
+        Vector4 operator*(const Vector4& rhs) const;
+        Vector4 operator*(Vector4View rhs) const;
+
+        bool operator==(Matrix4View rhs) const;
+        bool operator!=(Matrix4View rhs) const { return !(*this == rhs); }
+        bool Equals(Matrix4View other, float epsilon = 1e-5f) const;
+    };
+
+    struct Matrix3View
+    {
+        const float* data;
+        MatrixOrder order;
+        size_t stride;
+
+        Matrix3View(const float* data, MatrixOrder order = MatrixOrder::ColumnMajor, size_t stride = 3)
+            : data(data), order(order), stride(stride) {}
+        Matrix3View(const Matrix3& m) : data(&m.m1), order(MatrixOrder::ColumnMajor), stride(3) {}
+
+        float At(int row, int column) const
+        {
+            return order == MatrixOrder::ColumnMajor ? data[column * stride + row] : data[row * stride + column];
+        }
+
+        Matrix3View Transposed() const
+        {
+            return Matrix3View(data, order == MatrixOrder::ColumnMajor ? MatrixOrder::RowMajor : MatrixOrder::ColumnMajor, stride);
+        }
+
+        Matrix3 ToMatrix3() const;
+
+        Matrix3 operator*(const Matrix3View& rhs) const;
+        Vector3 operator*(const Vector3& rhs) const;
+        Vector3 operator*(Vector3View rhs) const;
+
+        bool operator==(Matrix3View rhs) const;
+        bool operator!=(Matrix3View rhs) const { return !(*this == rhs); }
+        bool Equals(Matrix3View other, float epsilon = 1e-5f) const;
+    };
+
+    // Write a matrix into an external buffer in the given order and stride
+    void Store(const Matrix4& m, float* out, MatrixOrder order = MatrixOrder::ColumnMajor, size_t stride = 4);
+    void Store(const Matrix3& m, float* out, MatrixOrder order = MatrixOrder::ColumnMajor, size_t stride = 3);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Matrix3.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <vector>
+
+namespace MathClasses
+{
+    // Matrix3 stored as three 16 byte aligned columns of four floats, so each column is one
+    // aligned SIMD load. Column c holds what Matrix3 keeps in m(3c+1)..m(3c+3); the fourth float
+    // of each column is padding, zero on construction and never read as data. Results match the
+    // Matrix3 operators bit for bit.
+    struct alignas(16) PaddedMatrix3
+    {
+        float m[12];
+
+        PaddedMatrix3();
+        explicit PaddedMatrix3(const Matrix3& packed);
+
+        Matrix3 ToMatrix3() const;
+
+        // Element in column-vector terms, the same one Matrix3View::At(row, column) reads
+        float At(int row, int column) const { return m[column * 4 + row]; }
+
+        PaddedMatrix3 operator*(const PaddedMatrix3& rhs) const;
+        Vector3 operator*(const Vector3& rhs) const;
+        PaddedMatrix3 Transposed() const;
+
+        // Compares the nine elements, the padding is ignored
+        bool operator==(const PaddedMatrix3& rhs) const;
+        bool operator!=(const PaddedMatrix3& rhs) const { return !(*this == rhs); }
+    };
+
+    // Owning array of padded matrices with bulk conversion from and to packed Matrix3 and
+    // element-wise batch operations
+    class PaddedMatrix3Array
+    {
+    public:
+        PaddedMatrix3Array() = default;
+        explicit PaddedMatrix3Array(size_t count) : items(count) {}
+        PaddedMatrix3Array(const Matrix3* packed, size_t count) { Assign(packed, count); }
+
+        size_t Size() const { return items.size(); }
+        void Resize(size_t count) { items.resize(count); }
+        PaddedMatrix3* Data() { return items.data(); }
+        const PaddedMatrix3* Data() const { return items.data(); }
+        PaddedMatrix3& operator[](size_t i) { return items[i]; }
+        const PaddedMatrix3& operator[](size_t i) const { return items[i]; }
+
+        void Assign(const Matrix3* packed, size_t count);
+        // out must have room for Size() matrices
+        void CopyTo(Matrix3* out) const;
+
+        // out[i] = (*this)[i] * rhs, or * rhs[i]; out is resized and may be *this
+        void Multiply(const PaddedMatrix3& rhs, PaddedMatrix3Array& out) const;
+        void Multiply(const PaddedMatrix3Array& rhs, PaddedMatrix3Array& out) const;
+
+        // out[i] = (*this)[i] * vectors[i]
+        void Transform(const Vector3* vectors, Vector3* out) const;
+
+    private:
+        std::vector<PaddedMatrix3> items;
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace MathClasses
+{
+    namespace Parallel
+    {
+        // Smallest range For hands out when the caller leaves the grain to it
+        constexpr size_t AutoGrain = 4096;
+
+        // Number of threads a parallel loop runs on, the caller included. Defaults to the
+        // hardware thread count.
+        unsigned WorkerCount();
+
+        // Resizes the thread pool to count threads (the caller being one of them); 0 goes back to
+        // the hardware thread count. Waits for a running loop to finish first.
+        void SetWorkerCount(unsigned count);
+
+        // Splits [0, count) into at most chunkCount contiguous ranges and runs
+        // fn(chunkIndex, begin, end) for each of them concurrently. The chunks are shared out
+        // over a pool of threads that is kept between calls; idle threads steal half of a busy
+        // one's remaining chunks. Calls made from inside fn run serially on the calling thread.
+        // If fn throws, the chunks not yet started are skipped and the first exception is
+        // rethrown here once no thread is still running one.
+        void ForChunks(size_t count, size_t chunkCount, const std::function<void(size_t, size_t, size_t)>& fn);
+
+        // Runs fn(begin, end) over [0, count) in ranges of at least minGrain elements, a few
+        // ranges per thread so stealing can even out uneven ones. minGrain 0 uses AutoGrain.
+        void For(size_t count, size_t minGrain, const std::function<void(size_t, size_t)>& fn);
+    }
+}
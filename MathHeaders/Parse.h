@@ -0,0 +1,32 @@
+#pragma once
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Colour.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    namespace Parse
+    {
+        // Parse one value in the text form FormatTo/ToString writes, skipping leading whitespace.
+        // Numbers go through std::from_chars, so any precision (and nan/inf) is accepted.
+        // Returns the position just past the value, or nullptr if the text is malformed.
+        const char* Value(const char* first, const char* last, Vector3& out);
+        const char* Value(const char* first, const char* last, Vector4& out);
+        const char* Value(const char* first, const char* last, Matrix3& out);
+        const char* Value(const char* first, const char* last, Matrix4& out);
+        // "#RRGGBBAA", or "#RRGGBB" with alpha 255
+        const char* Value(const char* first, const char* last, Colour& out);
+
+        // Parse consecutive values separated by whitespace and/or commas, up to capacity of them.
+        // Returns how many were read; stop (optional) receives where parsing ended, which is last
+        // unless capacity ran out or the text at that point is malformed.
+        size_t Many(const char* first, const char* last, Vector3* out, size_t capacity, const char** stop = nullptr);
+        size_t Many(const char* first, const char* last, Vector4* out, size_t capacity, const char** stop = nullptr);
+        size_t Many(const char* first, const char* last, Matrix3* out, size_t capacity, const char** stop = nullptr);
+        size_t Many(const char* first, const char* last, Matrix4* out, size_t capacity, const char** stop = nullptr);
+        size_t Many(const char* first, const char* last, Colour* out, size_t capacity, const char** stop = nullptr);
+    }
+}
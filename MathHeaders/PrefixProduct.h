@@ -0,0 +1,19 @@
+#pragma once
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    // Matrices per block of the parallel scan. The split into blocks depends only on this, never
+    // on the thread count, so results are the same bit for bit on any machine.
+    constexpr size_t PrefixProductBlock = 1024;
+
+    // out[k] = in[0] * in[1] * ... * in[k], with operator*'s products (out may be in). Up to
+    // PrefixProductBlock matrices this is the serial left fold exactly. Longer chains are cut into
+    // blocks whose totals are multiplied up serially, and each block is then folded onto the
+    // product of the ones before it, in parallel: the k-th result is
+    // (carry * in[blockStart]) * ... * in[k], the same maths in a different rounding order.
+    void PrefixProducts(const Matrix4* in, Matrix4* out, size_t count);
+    void PrefixProducts(const Matrix3* in, Matrix3* out, size_t count);
+}
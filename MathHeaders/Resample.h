@@ -0,0 +1,19 @@
+#pragma once
+#include "Colour.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    enum class ResampleFilter
+    {
+        Box,        // area average when shrinking, nearest neighbour when growing
+        Bilinear,   // triangle filter
+        Lanczos3    // windowed sinc with three lobes
+    };
+
+    // Resample a packed Colour image to a new size with a separable filter. The filter is
+    // widened when shrinking so every source pixel contributes, and edges are clamped.
+    // Both passes split their rows across worker threads.
+    void Resample(const Colour* src, size_t srcWidth, size_t srcHeight,
+        Colour* dst, size_t dstWidth, size_t dstHeight, ResampleFilter filter);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// SSE2 is always available on x64 and on Win32 builds using /arch:SSE2.
+// Define MATHCLASSES_NO_SIMD to force the scalar code paths.
+#if !defined(MATHCLASSES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHCLASSES_SSE2 1
+#include <emmintrin.h>
+#endif
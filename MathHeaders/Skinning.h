@@ -0,0 +1,49 @@
+#pragma once
+#include "Matrix4.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MathClasses
+{
+    enum class SkinningMode
+    {
+        Linear,         // blend the bone matrices by weight, then transform
+        DualQuaternion  // blend the bones as unit dual quaternions; rigid bones only, no scale
+    };
+
+    // Source streams of a skinned mesh, one float array per component. Every vertex has four
+    // influences: bones[4 * i + j] indexes the palette and weights[4 * i + j] weighs it. Weights
+    // should sum to 1; an unused influence can point at any valid bone with weight 0. Leave nx
+    // null for a mesh without normals.
+    struct SkinInput
+    {
+        const float* x;
+        const float* y;
+        const float* z;
+        const float* nx = nullptr;
+        const float* ny = nullptr;
+        const float* nz = nullptr;
+        const uint16_t* bones;
+        const float* weights;
+    };
+
+    // Destination streams; they may be the source ones. nx is ignored when the input has none.
+    struct SkinOutput
+    {
+        float* x;
+        float* y;
+        float* z;
+        float* nx = nullptr;
+        float* ny = nullptr;
+        float* nz = nullptr;
+    };
+
+    // Skins count vertices against a palette of boneCount matrices. Linear mode transforms
+    // positions by the blended matrix as a point and normals by its upper 3x3, renormalised (a
+    // zero normal stays zero). Dual quaternion mode takes the rotation and translation out of each
+    // bone, so bones must be rigid transforms; it avoids the volume loss of blended rotations and
+    // keeps normals unit length. SSE2 handles four vertices at a time; large meshes are split
+    // across worker threads.
+    void Skin(const SkinInput& in, const Matrix4* palette, size_t boneCount, const SkinOutput& out, size_t count,
+        SkinningMode mode = SkinningMode::Linear);
+}
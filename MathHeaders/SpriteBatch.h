@@ -0,0 +1,24 @@
+#pragma once
+#include "Colour.h"
+#include "Matrix3.h"
+#include "Vector2.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    // One corner of a sprite quad, laid out for a packed 20 byte vertex stream
+    struct SpriteVertex
+    {
+        float x, y;     // corner position after the sprite's transform
+        float u, v;     // texture coordinate, 0 or 1
+        Colour colour;  // the sprite's tint, copied unchanged
+    };
+
+    // Expands count sprites into four vertices each. Sprite i is a size.x by size.y quad centred
+    // on its origin and placed by transforms[i] as TransformPoint2D places points; its vertices
+    // are out[4 * i] to out[4 * i + 3], running bottom-left, bottom-right, top-right, top-left
+    // with uv (0, 0), (1, 0), (1, 1), (0, 1), so one shared 0 1 2, 2 3 0 index pattern draws
+    // them. out must hold 4 * count vertices and may be a mapped upload buffer: it is only
+    // written, sequentially within each range. Large batches are split across worker threads.
+    void BatchSprites(const Matrix3* transforms, const Colour* tints, size_t count, const Vector2& size, SpriteVertex* out);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "Colour.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    enum class TonemapCurve
+    {
+        Clamp,      // no curve, values above 1 are clipped
+        Reinhard,   // x / (1 + x)
+        ACES        // Narkowicz fit of the ACES filmic curve
+    };
+
+    struct TonemapSettings
+    {
+        float exposure = 1.0f;
+        TonemapCurve curve = TonemapCurve::Reinhard;
+        bool srgb = true;       // encode with the sRGB transfer function
+        bool dither = false;    // 4x4 ordered dither before quantising to 8 bits
+    };
+
+    // Apply a tonemap curve to a single linear value
+    float ApplyTonemap(float value, TonemapCurve curve);
+
+    // Exact sRGB transfer function for a linear value in [0, 1]
+    float LinearToSrgb(float value);
+
+    // Tonemap a width x height RGBA float image (four floats per pixel, rows packed)
+    // and pack the result into out. Exposure, curve and dither only touch RGB; alpha
+    // is clamped. Rows are split across worker threads.
+    void TonemapToColour(const float* rgba, Colour* out, size_t width, size_t height, const TonemapSettings& settings = TonemapSettings());
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "Matrix4.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace MathClasses
+{
+    // A fixed-size array of Matrix4 shared between one writer thread and any number of readers,
+    // without locks. The writer fills a back buffer and publishes it as a whole frame; readers
+    // take the latest published frame as a snapshot that stays unchanged while they hold it.
+    // Every frame records, per block of BlockSize matrices, the frame that last wrote it, so
+    // consumers can copy just what changed since the frame they already have.
+    //
+    // Frames are numbered from 1, the all-identity state the store is constructed with, so a
+    // consumer that has nothing yet asks for the changes since frame 0.
+    //
+    // Readers never wait. The writer only waits in BeginFrame when readers still hold every buffer
+    // but the latest; three buffers cover readers that copy out and let go, more buffers let
+    // snapshots be held longer.
+    class TransformStore
+    {
+    public:
+        static constexpr size_t BlockSize = 64;
+
+        // A published frame, kept from being reused while it is held. Move-only; release it
+        // before the store goes away.
+        class Snapshot
+        {
+        public:
+            Snapshot() = default;
+            Snapshot(Snapshot&& other) noexcept;
+            Snapshot& operator=(Snapshot&& other) noexcept;
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+            ~Snapshot();
+
+            const Matrix4* Data() const;
+            const Matrix4& operator[](size_t index) const;
+            size_t Size() const;
+            uint64_t Frame() const;
+
+            // fn(begin, end) over the ranges written after frame since, adjacent blocks merged
+            void ForEachChanged(uint64_t since, const std::function<void(size_t, size_t)>& fn) const;
+            // Copies those ranges into dst (Size() matrices) and returns how many were copied
+            size_t CopyChanged(uint64_t since, Matrix4* dst) const;
+
+        private:
+            friend class TransformStore;
+            const TransformStore* store = nullptr;
+            size_t buffer = 0;
+        };
+
+        explicit TransformStore(size_t count, size_t bufferCount = 3);
+        ~TransformStore();
+        TransformStore(const TransformStore&) = delete;
+        TransformStore& operator=(const TransformStore&) = delete;
+
+        size_t Size() const;
+
+        // Writer side, from one thread at a time. BeginFrame returns the back buffer holding the
+        // latest published frame (the blocks changed since the buffer's own frame are copied in);
+        // calling it again before Publish returns the same buffer. Set writes one matrix, other
+        // writes through the pointer need MarkDirty. Publish makes the frame visible to new
+        // snapshots and returns its number.
+        Matrix4* BeginFrame();
+        void Set(size_t index, const Matrix4& m);
+        void MarkDirty(size_t begin, size_t end);
+        uint64_t Publish();
+
+        // Reader side, from any thread
+        Snapshot Acquire() const;
+        uint64_t LatestFrame() const;
+
+    private:
+        struct Buffer;
+
+        void Release(size_t buffer) const;
+
+        size_t count;
+        size_t blockCount;
+        size_t bufferCount;
+        std::unique_ptr<Buffer[]> buffers;
+        std::atomic<size_t> current;
+        std::atomic<uint64_t> latestFrame;
+        size_t writing;
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "SimdConfig.h"
+
+#if MATHCLASSES_SSE2
+namespace MathClasses
+{
+    namespace Simd
+    {
+        // Largest |angle| SinCos4 takes; beyond it the pi/2 reduction below is no longer exact
+        // enough and callers fall back to std::sin/std::cos
+        constexpr float SinCosLimit = 65536.0f;
+
+        // sin and cos of two doubles with |x| <= SinCosLimit: Cody-Waite reduction by pi/2 and the
+        // Cephes polynomials on [-pi/4, pi/4], within an ulp or two of libm in double precision
+        inline void SinCos2(__m128d x, __m128d& s, __m128d& c)
+        {
+            __m128i q = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(0.63661977236758134308)));
+            __m128d qd = _mm_cvtepi32_pd(q);
+            // pi/2 in three 33-bit parts, so each q * part is exact
+            __m128d r = _mm_sub_pd(x, _mm_mul_pd(qd, _mm_set1_pd(1.57079632673412561417e+00)));
+            r = _mm_sub_pd(r, _mm_mul_pd(qd, _mm_set1_pd(6.07710050630396597660e-11)));
+            r = _mm_sub_pd(r, _mm_mul_pd(qd, _mm_set1_pd(2.02226624871116645580e-21)));
+
+            __m128d z = _mm_mul_pd(r, r);
+            __m128d ps = _mm_set1_pd(1.58962301576546568060e-10);
+            ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-2.50507477628578072866e-8));
+            ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(2.75573136213857245213e-6));
+            ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-1.98412698295895385996e-4));
+            ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(8.33333333332211858878e-3));
+            ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-1.66666666666666307295e-1));
+            __m128d sr = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, z), ps));
+
+            __m128d pc = _mm_set1_pd(-1.13585365213876817300e-11);
+            pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(2.08757008419747316778e-9));
+            pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(-2.75573141792967388112e-7));
+            pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(2.48015872888517045348e-5));
+            pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(-1.38888888888730564116e-3));
+            pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(4.16666666666665929218e-2));
+            __m128d cr = _mm_sub_pd(_mm_set1_pd(1.0), _mm_mul_pd(z, _mm_set1_pd(0.5)));
+            cr = _mm_add_pd(cr, _mm_mul_pd(_mm_mul_pd(z, z), pc));
+
+            // quadrant q: odd ones swap sin and cos, sin flips sign in 2 and 3, cos in 1 and 2
+            __m128i qq = _mm_shuffle_epi32(q, _MM_SHUFFLE(1, 1, 0, 0));
+            __m128d swap = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(qq, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+            __m128d sinSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(qq, _mm_set1_epi32(2)), 62));
+            __m128d cosSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(_mm_add_epi32(qq, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 62));
+            s = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, cr), _mm_andnot_pd(swap, sr)), sinSign);
+            c = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, sr), _mm_andnot_pd(swap, cr)), cosSign);
+        }
+
+        // static_cast<float>(std::sin(double(a))) and the cos of it for four angles. Returns false
+        // and leaves s and c alone when any angle is NaN or beyond SinCosLimit.
+        inline bool SinCos4(__m128 angles, __m128& s, __m128& c)
+        {
+            __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), angles);
+            if (_mm_movemask_ps(_mm_cmple_ps(magnitude, _mm_set1_ps(SinCosLimit))) != 0xf) {
+                return false;
+            }
+            __m128d s01, c01, s23, c23;
+            SinCos2(_mm_cvtps_pd(angles), s01, c01);
+            SinCos2(_mm_cvtps_pd(_mm_movehl_ps(angles, angles)), s23, c23);
+            s = _mm_movelh_ps(_mm_cvtpd_ps(s01), _mm_cvtpd_ps(s23));
+            c = _mm_movelh_ps(_mm_cvtpd_ps(c01), _mm_cvtpd_ps(c23));
+            return true;
+        }
+
+        // std::round(v * 1e6f) / 1e6f, as RoundToMat3 and RoundToMat4 do with 6 decimal places:
+        // halves round away from zero and the sign of zero is kept. |v| must stay below 2000.
+        inline __m128 Round6(__m128 v)
+        {
+            const __m128 scale = _mm_set1_ps(1e6f);
+            __m128 x = _mm_mul_ps(v, scale);
+            __m128 sign = _mm_and_ps(x, _mm_set1_ps(-0.0f));
+            __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+            __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(magnitude));
+            __m128 up = _mm_and_ps(_mm_cmpge_ps(_mm_sub_ps(magnitude, whole), _mm_set1_ps(0.5f)), _mm_set1_ps(1.0f));
+            return _mm_div_ps(_mm_or_ps(_mm_add_ps(whole, up), sign), scale);
+        }
+    }
+}
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace MathClasses
+{
+    struct Vector2
+    {
+        float x, y;
+
+        // Constructors
+        Vector2();
+        Vector2(float x2d, float y2d);
+
+        // Addition
+        Vector2 operator+(const Vector2& rhs) const;
+        Vector2& operator+=(const Vector2& rhs);
+
+        // Subtraction
+        Vector2 operator-(const Vector2& rhs) const;
+        Vector2& operator-=(const Vector2& rhs);
+
+        // Vector scalar multiplication
+        Vector2 operator*(float scalar) const;
+        friend Vector2 operator*(float scalar, const Vector2& lhs);
+        Vector2& operator*=(float scalar);
+
+        // Vector scalar division
+        Vector2 operator/(float scalar) const;
+        Vector2& operator/=(float scalar);
+
+        // Magnitude
+        float Magnitude() const;
+
+        // Magnitude squared
+        float MagnitudeSqr() const;
+
+        // Vector normalization
+        void Normalise();
+        Vector2 Normalised() const;
+
+        // Distance
+        float Distance(const Vector2& other) const;
+
+        // Dot product
+        float Dot(const Vector2& other) const;
+
+        // Equality operators
+        bool operator==(const Vector2& rhs) const;
+        bool operator!=(const Vector2& rhs) const;
+
+        //to string
+        std::string ToString() const;
+        // Writes ToString's text into buffer without allocating and returns its full length, like
+        // snprintf. precision is the number of decimals, -1 keeps Vector3's 6.
+        size_t FormatTo(char* buffer, size_t size, int precision = -1) const;
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace MathClasses
@@ -53,5 +54,8 @@ namespace MathClasses
 
         //to string
         std::string ToString() const;
+        // Writes ToString's text into buffer without allocating and returns its full length, like
+        // snprintf. precision is the number of decimals, -1 keeps ToString's 6.
+        size_t FormatTo(char* buffer, size_t size, int precision = -1) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+#include "Matrix4.h"
+#include <cstddef>
+
+namespace MathClasses
+{
+    // In-place transforms of one float3 attribute of an interleaved vertex buffer, so positions
+    // and normals no longer have to be copied out into a Vector4 array and scattered back.
+    // base is the first vertex, stride the size of a vertex in bytes and offset the byte offset
+    // of the attribute inside it (offset + 12 <= stride). The attribute needs no alignment.
+    // The w row of the matrix is not used.
+
+    // Positions, the same as m * Vector4(x, y, z, 1) without a perspective divide
+    void TransformPoints(const Matrix4& m, void* base, size_t stride, size_t offset, size_t count);
+
+    // Directions and normals, w = 0: the translation is never read. Normals of a non-uniformly
+    // scaled mesh need the inverse transpose of the matrix, and are not renormalised.
+    void TransformDirections(const Matrix4& m, void* base, size_t stride, size_t offset, size_t count);
+}
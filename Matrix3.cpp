@@ -1,5 +1,9 @@
 #include "MathHeaders/Matrix3.h"
-#include <sstream>
+#include "MathHeaders/Compare.h"
+#include "MathHeaders/Instrument.h"
+#include "MathHeaders/Format.h"
+#include "MathHeaders/SimdConfig.h"
+#include "MathHeaders/TrigSimd.h"
 #include <cmath>  
 
 namespace MathClasses {
@@ -24,6 +28,8 @@ namespace MathClasses {
 
     // Matrix multiplication
     Matrix3 Matrix3::operator*(const Matrix3& rhs) const {
+        MATHCLASSES_SCOPE(Matrix3Multiply);
+
         return Matrix3(
             m1 * rhs.m1 + m4 * rhs.m2 + m7 * rhs.m3,
             m2 * rhs.m1 + m5 * rhs.m2 + m8 * rhs.m3,
@@ -41,6 +47,8 @@ namespace MathClasses {
 
     // Matrix-vector multiplication
     Vector3 Matrix3::operator*(const Vector3& rhs) const {
+        MATHCLASSES_SCOPE(Matrix3MultiplyVector);
+
         return Vector3(
             m1 * rhs.x + m4 * rhs.y + m7 * rhs.z,
             m2 * rhs.x + m5 * rhs.y + m8 * rhs.z,
@@ -48,6 +56,61 @@ namespace MathClasses {
         );
     }
 
+    // Same summation order as operator*(Vector3(x, y, 1)), so the results match it bit for bit
+    Vector2 Matrix3::TransformPoint2D(const Vector2& p) const {
+        MATHCLASSES_COUNT(Matrix3MultiplyVector);
+
+        return Vector2(m1 * p.x + m4 * p.y + m7, m2 * p.x + m5 * p.y + m8);
+    }
+
+    void Matrix3::TransformPoints2D(const float* x, const float* y, float* outX, float* outY, size_t count) const {
+        MATHCLASSES_COUNT_N(Matrix3MultiplyVector, count);
+
+        size_t i = 0;
+#if MATHCLASSES_SSE2
+        const __m128 a = _mm_set1_ps(m1), b = _mm_set1_ps(m4), c = _mm_set1_ps(m7);
+        const __m128 d = _mm_set1_ps(m2), e = _mm_set1_ps(m5), f = _mm_set1_ps(m8);
+        for (; i + 4 <= count; i += 4) {
+            __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i);
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, vx), _mm_mul_ps(b, vy)), c);
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d, vx), _mm_mul_ps(e, vy)), f);
+            _mm_storeu_ps(outX + i, rx);
+            _mm_storeu_ps(outY + i, ry);
+        }
+#endif
+        for (; i < count; ++i) {
+            float px = x[i], py = y[i];
+            outX[i] = m1 * px + m4 * py + m7;
+            outY[i] = m2 * px + m5 * py + m8;
+        }
+    }
+
+    void Matrix3::TransformPoints2D(const Vector2* points, Vector2* out, size_t count) const {
+        if (count == 0) {
+            return;
+        }
+        MATHCLASSES_COUNT_N(Matrix3MultiplyVector, count);
+
+        size_t i = 0;
+#if MATHCLASSES_SSE2
+        // two interleaved points per register
+        const __m128 cx = _mm_setr_ps(m1, m2, m1, m2), cy = _mm_setr_ps(m4, m5, m4, m5), ct = _mm_setr_ps(m7, m8, m7, m8);
+        const float* in = &points[0].x;
+        float* dst = &out[0].x;
+        for (; i + 2 <= count; i += 2) {
+            __m128 v = _mm_loadu_ps(in + 2 * i);
+            __m128 vx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 vy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+            _mm_storeu_ps(dst + 2 * i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, vx), _mm_mul_ps(cy, vy)), ct));
+        }
+#endif
+        // the arithmetic of TransformPoint2D, which would count the points a second time
+        for (; i < count; ++i) {
+            Vector2 p = points[i];
+            out[i] = Vector2(m1 * p.x + m4 * p.y + m7, m2 * p.x + m5 * p.y + m8);
+        }
+    }
+
     // Set methods
     void Matrix3::Set(const Matrix3& m) {
         m1 = m.m1; m2 = m.m2; m3 = m.m3;
@@ -84,6 +147,9 @@ namespace MathClasses {
 
     // Rotation
     void Matrix3::SetRotateX(double radians) {
+        MATHCLASSES_SCOPE(Rotate);
+        MATHCLASSES_COUNT_N(Trig, 2);
+
         double c = std::cos(radians);
         double s = std::sin(radians);
 
@@ -95,6 +161,9 @@ namespace MathClasses {
     }
 
     void Matrix3::SetRotateY(double radians) {
+        MATHCLASSES_SCOPE(Rotate);
+        MATHCLASSES_COUNT_N(Trig, 2);
+
         double c = std::cos(radians);
         double s = std::sin(radians);
 
@@ -106,6 +175,9 @@ namespace MathClasses {
     }
 
     void Matrix3::SetRotateZ(double radians) {
+        MATHCLASSES_SCOPE(Rotate);
+        MATHCLASSES_COUNT_N(Trig, 2);
+
         double c = std::cos(radians);
         double s = std::sin(radians);
 
@@ -134,18 +206,81 @@ namespace MathClasses {
         Set(*this * m);
     }
 
+    // z * y * x multiplied out: each angle's sin and cos is taken and rounded once, as SetRotateX/Y/Z
+    // would, and the products keep the order the full 3x3 multiplies evaluate them in, so the
+    // result is the same (bar the sign of a zero) without the six rotation-matrix roundings
     void Matrix3::SetRotated(float pitch, float yaw, float roll) {
-        Matrix3 x, y, z;
-        x.SetRotateX(static_cast<double>(pitch));
-        y.SetRotateY(static_cast<double>(yaw));
-        z.SetRotateZ(static_cast<double>(roll));
-
-        Matrix3 result = z * y * x;
-
-        // Consistent rounding applied to final results
-        m1 = RoundToMat3(result.m1, 6); m2 = RoundToMat3(result.m2, 6); m3 = RoundToMat3(result.m3, 6);
-        m4 = RoundToMat3(result.m4, 6); m5 = RoundToMat3(result.m5, 6); m6 = RoundToMat3(result.m6, 6);
-        m7 = RoundToMat3(result.m7, 6); m8 = RoundToMat3(result.m8, 6); m9 = RoundToMat3(result.m9, 6);
+        MATHCLASSES_SCOPE(MakeEuler);
+        MATHCLASSES_COUNT_N(Trig, 6);
+
+        float cx = RoundToMat3(std::cos(static_cast<double>(pitch)), 6), sx = RoundToMat3(std::sin(static_cast<double>(pitch)), 6);
+        float cy = RoundToMat3(std::cos(static_cast<double>(yaw)), 6), sy = RoundToMat3(std::sin(static_cast<double>(yaw)), 6);
+        float cz = RoundToMat3(std::cos(static_cast<double>(roll)), 6), sz = RoundToMat3(std::sin(static_cast<double>(roll)), 6);
+
+        m1 = RoundToMat3(cz * cy, 6);
+        m2 = RoundToMat3(sz * cy, 6);
+        m3 = RoundToMat3(sy, 6);
+        m4 = RoundToMat3(-(sz * cx) + cz * sy * sx, 6);
+        m5 = RoundToMat3(cz * cx + sz * sy * sx, 6);
+        m6 = RoundToMat3(-(cy * sx), 6);
+        m7 = RoundToMat3(-(sz * sx) - cz * sy * cx, 6);
+        m8 = RoundToMat3(cz * sx - sz * sy * cx, 6);
+        m9 = RoundToMat3(cy * cx, 6);
+    }
+
+    void Matrix3::MakeEuler(const Vector3* euler, Matrix3* out, size_t count) {
+        size_t i = 0;
+#if MATHCLASSES_SSE2
+        // four matrices with one register per element, the arithmetic of SetRotated lane by lane
+        for (; i + 4 <= count; i += 4) {
+            const Vector3* e = euler + i;
+            __m128 sx, cx, sy, cy, sz, cz;
+            if (!Simd::SinCos4(_mm_setr_ps(e[0].x, e[1].x, e[2].x, e[3].x), sx, cx) ||
+                !Simd::SinCos4(_mm_setr_ps(e[0].y, e[1].y, e[2].y, e[3].y), sy, cy) ||
+                !Simd::SinCos4(_mm_setr_ps(e[0].z, e[1].z, e[2].z, e[3].z), sz, cz)) {
+                for (size_t j = 0; j < 4; ++j) {
+                    out[i + j].SetRotated(e[j].x, e[j].y, e[j].z);
+                }
+                continue;
+            }
+            MATHCLASSES_COUNT_N(MakeEuler, 4);
+            MATHCLASSES_COUNT_N(Trig, 24);
+            sx = Simd::Round6(sx); cx = Simd::Round6(cx);
+            sy = Simd::Round6(sy); cy = Simd::Round6(cy);
+            sz = Simd::Round6(sz); cz = Simd::Round6(cz);
+
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            __m128 czsy = _mm_mul_ps(cz, sy), szsy = _mm_mul_ps(sz, sy);
+            __m128 a1 = Simd::Round6(_mm_mul_ps(cz, cy));
+            __m128 a2 = Simd::Round6(_mm_mul_ps(sz, cy));
+            __m128 a3 = Simd::Round6(sy);
+            __m128 a4 = Simd::Round6(_mm_add_ps(_mm_xor_ps(_mm_mul_ps(sz, cx), sign), _mm_mul_ps(czsy, sx)));
+            __m128 a5 = Simd::Round6(_mm_add_ps(_mm_mul_ps(cz, cx), _mm_mul_ps(szsy, sx)));
+            __m128 a6 = Simd::Round6(_mm_xor_ps(_mm_mul_ps(cy, sx), sign));
+            __m128 a7 = Simd::Round6(_mm_sub_ps(_mm_xor_ps(_mm_mul_ps(sz, sx), sign), _mm_mul_ps(czsy, cx)));
+            __m128 a8 = Simd::Round6(_mm_sub_ps(_mm_mul_ps(cz, sx), _mm_mul_ps(szsy, cx)));
+            __m128 a9 = Simd::Round6(_mm_mul_ps(cy, cx));
+
+            _MM_TRANSPOSE4_PS(a1, a2, a3, a4);
+            _MM_TRANSPOSE4_PS(a5, a6, a7, a8);
+            float* dst = &out[i].m1;
+            _mm_storeu_ps(dst, a1);
+            _mm_storeu_ps(dst + 4, a5);
+            _mm_store_ss(dst + 8, a9);
+            _mm_storeu_ps(dst + 9, a2);
+            _mm_storeu_ps(dst + 13, a6);
+            _mm_store_ss(dst + 17, _mm_shuffle_ps(a9, a9, _MM_SHUFFLE(1, 1, 1, 1)));
+            _mm_storeu_ps(dst + 18, a3);
+            _mm_storeu_ps(dst + 22, a7);
+            _mm_store_ss(dst + 26, _mm_shuffle_ps(a9, a9, _MM_SHUFFLE(2, 2, 2, 2)));
+            _mm_storeu_ps(dst + 27, a4);
+            _mm_storeu_ps(dst + 31, a8);
+            _mm_store_ss(dst + 35, _mm_shuffle_ps(a9, a9, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i].SetRotated(euler[i].x, euler[i].y, euler[i].z);
+        }
     }
 
     // Translation
@@ -169,11 +304,27 @@ namespace MathClasses {
 
     // ToString method
     std::string Matrix3::ToString() const {
-        std::ostringstream oss;
-        oss << "[" << m1 << ", " << m2 << ", " << m3 << "], "
-            << "[" << m4 << ", " << m5 << ", " << m6 << "], "
-            << "[" << m7 << ", " << m8 << ", " << m9 << "]";
-        return oss.str();
+        MATHCLASSES_COUNT(ToString);
+
+        return Format::ToString(*this);
+    }
+
+    size_t Matrix3::FormatTo(char* buffer, size_t size, int precision) const {
+        // matches the ostream default the old ToString used, "%g" with 6 significant digits
+        int digits = precision < 0 ? 6 : precision;
+        const float values[9] = { m1, m2, m3, m4, m5, m6, m7, m8, m9 };
+        Format::Writer out(buffer, size);
+        for (int row = 0; row < 3; ++row) {
+            out.Put(row == 0 ? "[" : "], [");
+            for (int col = 0; col < 3; ++col) {
+                if (col > 0) {
+                    out.Put(", ");
+                }
+                out.Put(values[row * 3 + col], std::chars_format::general, digits);
+            }
+        }
+        out.Put(']');
+        return out.Finish();
     }
 
     // Static factory methods
@@ -248,10 +399,122 @@ namespace MathClasses {
         );
     }
 
+    // Inverse by cofactors. The formulas read m1..m9 row by row, which inverts the transpose;
+    // the inverse of the transpose is the transpose of the inverse, so writing the result back
+    // the same way gives the inverse itself.
+    float Matrix3::Determinant() const {
+        return m1 * (m5 * m9 - m6 * m8) - m2 * (m4 * m9 - m6 * m7) + m3 * (m4 * m8 - m5 * m7);
+    }
+
+    bool Matrix3::TryInvert(Matrix3& out) const {
+        float invDet = 1.0f / Determinant();
+        if (!std::isfinite(invDet)) {
+            return false;
+        }
+        out = Matrix3(
+            (m5 * m9 - m6 * m8) * invDet, (m3 * m8 - m2 * m9) * invDet, (m2 * m6 - m3 * m5) * invDet,
+            (m6 * m7 - m4 * m9) * invDet, (m1 * m9 - m3 * m7) * invDet, (m3 * m4 - m1 * m6) * invDet,
+            (m4 * m8 - m5 * m7) * invDet, (m2 * m7 - m1 * m8) * invDet, (m1 * m5 - m2 * m4) * invDet
+        );
+        return true;
+    }
+
+    Matrix3 Matrix3::Inverted() const {
+        Matrix3 result;
+        TryInvert(result);
+        return result;
+    }
+
+    bool Matrix3::IsAffine2D() const {
+        return m3 == 0 && m6 == 0 && m9 == 1;
+    }
+
+    Matrix3 Matrix3::InvertedAffine2D() const {
+        float invDet = 1.0f / (m1 * m5 - m4 * m2);
+        if (!std::isfinite(invDet)) {
+            return Matrix3();
+        }
+        float a = m5 * invDet, b = -m2 * invDet, c = -m4 * invDet, d = m1 * invDet;
+        return Matrix3(
+            a, b, 0,
+            c, d, 0,
+            -(a * m7 + c * m8), -(b * m7 + d * m8), 1
+        );
+    }
+
+    size_t Matrix3::Invert(const Matrix3* in, Matrix3* out, size_t count) {
+        size_t singular = 0;
+        size_t i = 0;
+#if MATHCLASSES_SSE2
+        // four matrices with one register per element; the arithmetic is the same as TryInvert's,
+        // so the results are identical
+        for (; i + 4 <= count; i += 4) {
+            // the 36 floats of four matrices: two 4x4 transposes and the ninth elements on their own
+            const float* src = &in[i].m1;
+            __m128 a1 = _mm_loadu_ps(src), a2 = _mm_loadu_ps(src + 9), a3 = _mm_loadu_ps(src + 18), a4 = _mm_loadu_ps(src + 27);
+            __m128 a5 = _mm_loadu_ps(src + 4), a6 = _mm_loadu_ps(src + 13), a7 = _mm_loadu_ps(src + 22), a8 = _mm_loadu_ps(src + 31);
+            __m128 a9 = _mm_setr_ps(src[8], src[17], src[26], src[35]);
+            _MM_TRANSPOSE4_PS(a1, a2, a3, a4);
+            _MM_TRANSPOSE4_PS(a5, a6, a7, a8);
+            auto cross = [](__m128 a, __m128 b, __m128 c, __m128 d) {
+                return _mm_sub_ps(_mm_mul_ps(a, b), _mm_mul_ps(c, d));
+            };
+            __m128 c1 = cross(a5, a9, a6, a8), c4 = cross(a6, a7, a4, a9), c7 = cross(a4, a8, a5, a7);
+            // Determinant() subtracts m2 * (m4 m9 - m6 m7), c4 is its negation, so keep that form
+            __m128 det = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a1, c1), _mm_mul_ps(a2, cross(a4, a9, a6, a7))), _mm_mul_ps(a3, c7));
+            __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+            // finite lanes have exponent bits below all ones
+            __m128i exponent = _mm_set1_epi32(0x7f800000);
+            __m128 finite = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_and_si128(_mm_castps_si128(invDet), exponent), exponent));
+            int mask = _mm_movemask_ps(finite);
+
+            __m128 r1 = cross(a3, a8, a2, a9), r2 = cross(a2, a6, a3, a5), r4 = cross(a1, a9, a3, a7);
+            __m128 r5 = cross(a3, a4, a1, a6), r7 = cross(a2, a7, a1, a8), r8 = cross(a1, a5, a2, a4);
+            __m128 e1 = _mm_and_ps(_mm_mul_ps(c1, invDet), finite), e2 = _mm_and_ps(_mm_mul_ps(r1, invDet), finite);
+            __m128 e3 = _mm_and_ps(_mm_mul_ps(r2, invDet), finite), e4 = _mm_and_ps(_mm_mul_ps(c4, invDet), finite);
+            __m128 e5 = _mm_and_ps(_mm_mul_ps(r4, invDet), finite), e6 = _mm_and_ps(_mm_mul_ps(r5, invDet), finite);
+            __m128 e7 = _mm_and_ps(_mm_mul_ps(c7, invDet), finite), e8 = _mm_and_ps(_mm_mul_ps(r7, invDet), finite);
+            __m128 e9 = _mm_and_ps(_mm_mul_ps(r8, invDet), finite);
+
+            // and back to one matrix per 9 floats
+            _MM_TRANSPOSE4_PS(e1, e2, e3, e4);
+            _MM_TRANSPOSE4_PS(e5, e6, e7, e8);
+            float* dst = &out[i].m1;
+            _mm_storeu_ps(dst, e1);
+            _mm_storeu_ps(dst + 4, e5);
+            _mm_store_ss(dst + 8, e9);
+            _mm_storeu_ps(dst + 9, e2);
+            _mm_storeu_ps(dst + 13, e6);
+            _mm_store_ss(dst + 17, _mm_shuffle_ps(e9, e9, _MM_SHUFFLE(1, 1, 1, 1)));
+            _mm_storeu_ps(dst + 18, e3);
+            _mm_storeu_ps(dst + 22, e7);
+            _mm_store_ss(dst + 26, _mm_shuffle_ps(e9, e9, _MM_SHUFFLE(2, 2, 2, 2)));
+            _mm_storeu_ps(dst + 27, e4);
+            _mm_storeu_ps(dst + 31, e8);
+            _mm_store_ss(dst + 35, _mm_shuffle_ps(e9, e9, _MM_SHUFFLE(3, 3, 3, 3)));
+            for (int j = 0; j < 4; ++j) {
+                singular += (mask >> j & 1) ? 0 : 1;
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (!in[i].TryInvert(out[i])) {
+                out[i] = Matrix3();
+                ++singular;
+            }
+        }
+        return singular;
+    }
+
     // Equality operator
     bool Matrix3::operator==(const Matrix3& rhs) const {
         return m1 == rhs.m1 && m2 == rhs.m2 && m3 == rhs.m3 &&
             m4 == rhs.m4 && m5 == rhs.m5 && m6 == rhs.m6 &&
             m7 == rhs.m7 && m8 == rhs.m8 && m9 == rhs.m9;
     }
+
+    // All nine elements within epsilon, compared without early-outs (see Compare.h for other modes)
+    bool Matrix3::Equals(const Matrix3& rhs, float epsilon) const {
+        return Near(*this, rhs, Tolerance::Absolute(epsilon));
+    }
 }
\ No newline at end of file
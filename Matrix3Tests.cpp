@@ -8,6 +8,7 @@
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using ::MathClasses::Matrix3;
 using ::MathClasses::Vector3;
+using ::MathClasses::MAX_FLOAT_DELTA;
 
 namespace MathLibraryTests
 {
@@ -123,6 +124,116 @@ namespace MathLibraryTests
 
 			Assert::AreEqual(Matrix3(1, 4, 7, 2, 5, 8, 3, 6, 9), m3a);
 		}
+		// Determinant and general inverse
+		TEST_METHOD(Inverted)
+		{
+			Matrix3 m3a(1, 2, 3,
+				0, 1, 4,
+				5, 6, 0);
+			Assert::AreEqual(1.f, m3a.Determinant(), MAX_FLOAT_DELTA);
+
+			Matrix3 inverse;
+			Assert::IsTrue(m3a.TryInvert(inverse));
+			Assert::AreEqual(Matrix3(-24, 18, 5, 20, -15, -4, -5, 4, 1), inverse);
+			AssertIdentity(m3a * inverse);
+			AssertIdentity(inverse * m3a);
+			Assert::AreEqual(inverse, m3a.Inverted());
+		}
+		// Singular matrices are reported and invert to zero
+		TEST_METHOD(InvertedSingular)
+		{
+			Matrix3 m3a(1, 2, 3,
+				2, 4, 6,
+				7, 8, 9);
+			Assert::AreEqual(0.f, m3a.Determinant(), MAX_FLOAT_DELTA);
+
+			Matrix3 inverse = Matrix3::identity;
+			Assert::IsFalse(m3a.TryInvert(inverse));
+			Assert::AreEqual(Matrix3::identity, inverse);
+			Assert::AreEqual(Matrix3(), m3a.Inverted());
+		}
+		// 2D affine fast path agrees with the general inverse
+		TEST_METHOD(InvertedAffine2D)
+		{
+			Matrix3 m3a = Matrix3::MakeTranslation(4.f, -2.f) * Matrix3::MakeRotateZ(0.6f) * Matrix3::MakeScale(2.f, 0.5f);
+			Assert::IsTrue(m3a.IsAffine2D());
+			Assert::IsFalse(Matrix3::MakeRotateX(0.6f).IsAffine2D());
+
+			Matrix3 fast = m3a.InvertedAffine2D();
+			Matrix3 general = m3a.Inverted();
+			const float* f = &fast.m1;
+			const float* g = &general.m1;
+			for (int i = 0; i < 9; ++i)
+			{
+				Assert::AreEqual(g[i], f[i], MAX_FLOAT_DELTA);
+			}
+			AssertIdentity(m3a * fast);
+		}
+		// Batch inverse matches TryInvert, singular entries included
+		TEST_METHOD(InvertArray)
+		{
+			Matrix3 matrices[7];
+			for (int i = 0; i < 7; ++i)
+			{
+				matrices[i] = Matrix3::MakeRotateZ(0.3f * i) * Matrix3::MakeScale(1.f + i, 2.f, 1.f);
+			}
+			matrices[2] = Matrix3(1, 2, 3, 2, 4, 6, 7, 8, 9);
+			matrices[5] = Matrix3();
+
+			Matrix3 out[7];
+			Assert::AreEqual(size_t(2), Matrix3::Invert(matrices, out, 7));
+			for (int i = 0; i < 7; ++i)
+			{
+				Matrix3 expected;
+				matrices[i].TryInvert(expected);
+				Assert::AreEqual(expected, out[i]);
+			}
+
+			Matrix3::Invert(matrices, matrices, 7);
+			Assert::AreEqual(out[6], matrices[6]);
+		}
+		// the closed form gives what multiplying out the three rotations and rounding did
+		TEST_METHOD(MakeEulerMatchesRotationProduct)
+		{
+			for (int i = 0; i < 16; ++i)
+			{
+				float pitch = 0.37f * i - 3.0f, yaw = 1.1f - 0.29f * i, roll = 0.5f * i;
+				Matrix3 product = Matrix3::MakeRotateZ(roll) * Matrix3::MakeRotateY(yaw) * Matrix3::MakeRotateX(pitch);
+				float* m = &product.m1;
+				for (int j = 0; j < 9; ++j)
+				{
+					m[j] = Matrix3::RoundToMat3(m[j], 6);
+				}
+				Assert::AreEqual(product, Matrix3::MakeEuler(pitch, yaw, roll));
+			}
+		}
+		TEST_METHOD(MakeEulerArray)
+		{
+			Vector3 euler[7];
+			for (int i = 0; i < 7; ++i)
+			{
+				euler[i] = Vector3(0.7f * i - 2.0f, 1.3f - 0.4f * i, 3.0f * i);
+			}
+			euler[1].z = 1e6f;
+
+			Matrix3 out[7];
+			Matrix3::MakeEuler(euler, out, 7);
+			for (int i = 0; i < 7; ++i)
+			{
+				Assert::AreEqual(Matrix3::MakeEuler(euler[i]), out[i]);
+			}
+		}
+
+	private:
+		static void AssertIdentity(const Matrix3& m)
+		{
+			const float* actual = &m.m1;
+			const float* expected = &Matrix3::identity.m1;
+			for (int i = 0; i < 9; ++i)
+			{
+				Assert::AreEqual(expected[i], actual[i], MAX_FLOAT_DELTA);
+			}
+		}
 	};
 }
 
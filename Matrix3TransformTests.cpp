@@ -6,6 +6,7 @@
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using ::MathClasses::Matrix3;
+using ::MathClasses::Vector2;
 using ::MathClasses::Vector3;
 
 namespace MathLibraryTests
@@ -127,5 +128,42 @@ namespace MathLibraryTests
 					0.0f, 3.0f, 0.0f,
 					0.0f, 0.0f, 4.0f), actual);
 		}
+		// 2D affine point transform matches the Vector3 product with z = 1
+		TEST_METHOD(TransformPoint2D)
+		{
+			Matrix3 m = Matrix3::MakeTranslation(5.0f, -2.0f) * Matrix3::MakeRotateZ(0.75f) * Matrix3::MakeScale(2.0f, 3.0f);
+			Vector3 expected = m * Vector3(1.5f, -0.5f, 1.0f);
+
+			Assert::AreEqual(Vector2(expected.x, expected.y), m.TransformPoint2D(Vector2(1.5f, -0.5f)));
+			Assert::AreEqual(Vector2(6.0f, 1.0f), Matrix3::MakeTranslation(5.0f, 2.0f).TransformPoint2D(Vector2(1.0f, -1.0f)));
+		}
+		// SoA and Vector2 array batches, including the scalar tails and in place use
+		TEST_METHOD(TransformPoints2D)
+		{
+			Matrix3 m = Matrix3::MakeTranslation(5.0f, -2.0f) * Matrix3::MakeRotateZ(0.75f);
+			float x[7], y[7], ox[7], oy[7];
+			Vector2 points[7], out[7];
+			for (int i = 0; i < 7; ++i)
+			{
+				x[i] = 1.0f * i;
+				y[i] = 2.0f - i;
+				points[i] = Vector2(x[i], y[i]);
+			}
+
+			m.TransformPoints2D(x, y, ox, oy, 7);
+			m.TransformPoints2D(points, out, 7);
+			for (int i = 0; i < 7; ++i)
+			{
+				Vector2 expected = m.TransformPoint2D(points[i]);
+				Assert::AreEqual(expected, Vector2(ox[i], oy[i]));
+				Assert::AreEqual(expected, out[i]);
+			}
+
+			m.TransformPoints2D(points, points, 7);
+			Assert::AreEqual(out[6], points[6]);
+
+			// an empty batch never touches its arrays
+			m.TransformPoints2D(static_cast<const Vector2*>(nullptr), nullptr, 0);
+		}
 	};
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <ostream>
 #include "MathHeaders/Matrix4.h"
+#include "MathHeaders/Compare.h"
+#include "MathHeaders/Format.h"
+#include "MathHeaders/Instrument.h"
+#include "MathHeaders/SimdConfig.h"
+#include "MathHeaders/TrigSimd.h"
 
 namespace MathClasses
 {
@@ -38,6 +42,8 @@ namespace MathClasses
 
 	Matrix4 Matrix4::operator*(const Matrix4& rhs) const
 	{
+		MATHCLASSES_SCOPE(Matrix4Multiply);
+
 		return Matrix4(
 			// Row 1
 			rhs.m1 * m1 + rhs.m2 * m5 + rhs.m3 * m9 + rhs.m4 * m13,
@@ -67,6 +73,8 @@ namespace MathClasses
 
 	Vector4 Matrix4::operator*(const Vector4& rhs) const
 	{
+		MATHCLASSES_SCOPE(Matrix4MultiplyVector);
+
 		return Vector4(
 			rhs.x * m1 + rhs.y * m5 + rhs.z * m9 + rhs.w * m13,
 			rhs.x * m2 + rhs.y * m6 + rhs.z * m10 + rhs.w * m14,
@@ -75,6 +83,108 @@ namespace MathClasses
 		);
 	}
 
+	// Same summation order as operator*(Vector4), so points match it bit for bit
+	Vector3 Matrix4::TransformPoint(const Vector3& p) const
+	{
+		MATHCLASSES_SCOPE(Matrix4MultiplyVector);
+
+		return Vector3(
+			p.x * m1 + p.y * m5 + p.z * m9 + m13,
+			p.x * m2 + p.y * m6 + p.z * m10 + m14,
+			p.x * m3 + p.y * m7 + p.z * m11 + m15
+		);
+	}
+
+	Vector3 Matrix4::TransformDirection(const Vector3& d) const
+	{
+		MATHCLASSES_SCOPE(Matrix4MultiplyVector);
+
+		return Vector3(
+			d.x * m1 + d.y * m5 + d.z * m9,
+			d.x * m2 + d.y * m6 + d.z * m10,
+			d.x * m3 + d.y * m7 + d.z * m11
+		);
+	}
+
+	Vector3 Matrix4::TransformPointProjective(const Vector3& p) const
+	{
+		MATHCLASSES_SCOPE(Matrix4MultiplyVector);
+
+		float w = p.x * m4 + p.y * m8 + p.z * m12 + m16;
+		return Vector3(
+			(p.x * m1 + p.y * m5 + p.z * m9 + m13) / w,
+			(p.x * m2 + p.y * m6 + p.z * m10 + m14) / w,
+			(p.x * m3 + p.y * m7 + p.z * m11 + m15) / w
+		);
+	}
+
+	namespace
+	{
+		// Mode 0 is points, 1 directions, 2 projective points. Four elements per step with
+		// SSE2, in the same order of operations as the single versions above.
+		template<int Mode>
+		void TransformSoA(const Matrix4& m, const float* x, const float* y, const float* z,
+			float* outX, float* outY, float* outZ, size_t count)
+		{
+			size_t i = 0;
+#if MATHCLASSES_SSE2
+			const __m128 m1 = _mm_set1_ps(m.m1), m2 = _mm_set1_ps(m.m2), m3 = _mm_set1_ps(m.m3), m4 = _mm_set1_ps(m.m4);
+			const __m128 m5 = _mm_set1_ps(m.m5), m6 = _mm_set1_ps(m.m6), m7 = _mm_set1_ps(m.m7), m8 = _mm_set1_ps(m.m8);
+			const __m128 m9 = _mm_set1_ps(m.m9), m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12);
+			const __m128 m13 = _mm_set1_ps(m.m13), m14 = _mm_set1_ps(m.m14), m15 = _mm_set1_ps(m.m15), m16 = _mm_set1_ps(m.m16);
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+				__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m1), _mm_mul_ps(vy, m5)), _mm_mul_ps(vz, m9));
+				__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m2), _mm_mul_ps(vy, m6)), _mm_mul_ps(vz, m10));
+				__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m3), _mm_mul_ps(vy, m7)), _mm_mul_ps(vz, m11));
+				if (Mode != 1)
+				{
+					rx = _mm_add_ps(rx, m13);
+					ry = _mm_add_ps(ry, m14);
+					rz = _mm_add_ps(rz, m15);
+				}
+				if (Mode == 2)
+				{
+					__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m4), _mm_mul_ps(vy, m8)), _mm_mul_ps(vz, m12)), m16);
+					rx = _mm_div_ps(rx, w);
+					ry = _mm_div_ps(ry, w);
+					rz = _mm_div_ps(rz, w);
+				}
+				_mm_storeu_ps(outX + i, rx);
+				_mm_storeu_ps(outY + i, ry);
+				_mm_storeu_ps(outZ + i, rz);
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				Vector3 v(x[i], y[i], z[i]);
+				Vector3 r = Mode == 0 ? m.TransformPoint(v) : Mode == 1 ? m.TransformDirection(v) : m.TransformPointProjective(v);
+				outX[i] = r.x;
+				outY[i] = r.y;
+				outZ[i] = r.z;
+			}
+		}
+	}
+
+	void Matrix4::TransformPoints(const float* x, const float* y, const float* z,
+		float* outX, float* outY, float* outZ, size_t count) const
+	{
+		TransformSoA<0>(*this, x, y, z, outX, outY, outZ, count);
+	}
+
+	void Matrix4::TransformDirections(const float* x, const float* y, const float* z,
+		float* outX, float* outY, float* outZ, size_t count) const
+	{
+		TransformSoA<1>(*this, x, y, z, outX, outY, outZ, count);
+	}
+
+	void Matrix4::TransformPointsProjective(const float* x, const float* y, const float* z,
+		float* outX, float* outY, float* outZ, size_t count) const
+	{
+		TransformSoA<2>(*this, x, y, z, outX, outY, outZ, count);
+	}
+
 	bool Matrix4::operator==(const Matrix4& rhs) const
 	{
 		return m1 == rhs.m1 && m2 == rhs.m2 && m3 == rhs.m3 && m4 == rhs.m4 &&
@@ -88,6 +198,12 @@ namespace MathClasses
 		return !(*this == rhs);
 	}
 
+	// All sixteen elements within epsilon, compared without early-outs (see Compare.h for other modes)
+	bool Matrix4::Equals(const Matrix4& other, float epsilon) const
+	{
+		return Near(*this, other, Tolerance::Absolute(epsilon));
+	}
+
 	// Helper function to round to a certain number of decimal places
 	float Matrix4::RoundToMat4(float value, int decimalPlaces)
 	{
@@ -141,6 +257,9 @@ namespace MathClasses
 
 	void Matrix4::SetRotateX(double radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		m1 = 1; m2 = 0;           m3 = 0;          m4 = 0;
 		m5 = 0; m6 = cos(radians); m7 = sin(radians); m8 = 0;
 		m9 = 0; m10 = -sin(radians); m11 = cos(radians); m12 = 0;
@@ -149,6 +268,9 @@ namespace MathClasses
 
 	void Matrix4::SetRotateY(double radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		m1 = cos(radians);  m2 = 0; m3 = -sin(radians); m4 = 0;
 		m5 = 0;           m6 = 1; m7 = 0;           m8 = 0;
 		m9 = sin(radians);  m10 = 0; m11 = cos(radians);  m12 = 0;
@@ -157,6 +279,9 @@ namespace MathClasses
 
 	void Matrix4::SetRotateZ(double radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		m1 = cos(radians); m2 = sin(radians); m3 = 0; m4 = 0;
 		m5 = -sin(radians); m6 = cos(radians); m7 = 0; m8 = 0;
 		m9 = 0;            m10 = 0;           m11 = 1; m12 = 0;
@@ -236,6 +361,9 @@ namespace MathClasses
 
 	Matrix4 Matrix4::MakeRotateX(float radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		return Matrix4(
 			1, 0, 0, 0,
 			0, RoundToMat4(static_cast<float>(cos(radians)), 6), RoundToMat4(static_cast<float>(-sin(radians)), 6), 0,
@@ -246,6 +374,9 @@ namespace MathClasses
 
 	Matrix4 Matrix4::MakeRotateY(float radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		return Matrix4(
 			RoundToMat4(static_cast<float>(cos(radians)), 6), 0, RoundToMat4(static_cast<float>(sin(radians)), 6), 0,
 			0, 1, 0, 0,
@@ -256,6 +387,9 @@ namespace MathClasses
 
 	Matrix4 Matrix4::MakeRotateZ(float radians)
 	{
+		MATHCLASSES_SCOPE(Rotate);
+		MATHCLASSES_COUNT_N(Trig, 4);
+
 		return Matrix4(
 			RoundToMat4(static_cast<float>(cos(radians)), 6), RoundToMat4(static_cast<float>(sin(radians)), 6), 0, 0,
 			RoundToMat4(static_cast<float>(-sin(radians)), 6), RoundToMat4(static_cast<float>(cos(radians)), 6), 0, 0,
@@ -266,13 +400,17 @@ namespace MathClasses
 
 	Matrix4 Matrix4::MakeEuler(float pitch, float yaw, float roll)
 	{
-		// Calculate the sine and cosine of the pitch, yaw, and roll angles
-		float cp = cos(pitch);
-		float sp = sin(pitch);
-		float cy = cos(yaw);
-		float sy = sin(yaw);
-		float cr = cos(roll);
-		float sr = sin(roll);
+		MATHCLASSES_SCOPE(MakeEuler);
+		MATHCLASSES_COUNT_N(Trig, 6);
+
+		// Calculate the sine and cosine of the pitch, yaw, and roll angles, in double on every
+		// compiler (MSVC would pick the float overloads) so the batch MakeEuler can match them
+		float cp = static_cast<float>(std::cos(static_cast<double>(pitch)));
+		float sp = static_cast<float>(std::sin(static_cast<double>(pitch)));
+		float cy = static_cast<float>(std::cos(static_cast<double>(yaw)));
+		float sy = static_cast<float>(std::sin(static_cast<double>(yaw)));
+		float cr = static_cast<float>(std::cos(static_cast<double>(roll)));
+		float sr = static_cast<float>(std::sin(static_cast<double>(roll)));
 
 		// Compute the rotation matrix components
 		float m00 = cy * cr;
@@ -300,6 +438,65 @@ namespace MathClasses
 		return MakeEuler(euler.x, euler.y, euler.z);
 	}
 
+	void Matrix4::MakeEuler(const Vector3* euler, Matrix4* out, size_t count)
+	{
+		size_t i = 0;
+#if MATHCLASSES_SSE2
+		// four matrices with one register per element, the arithmetic of MakeEuler lane by lane;
+		// each register of rotation elements then transposes into one column of the four matrices
+		for (; i + 4 <= count; i += 4)
+		{
+			const Vector3* e = euler + i;
+			__m128 sp, cp, sy, cy, sr, cr;
+			if (!Simd::SinCos4(_mm_setr_ps(e[0].x, e[1].x, e[2].x, e[3].x), sp, cp) ||
+				!Simd::SinCos4(_mm_setr_ps(e[0].y, e[1].y, e[2].y, e[3].y), sy, cy) ||
+				!Simd::SinCos4(_mm_setr_ps(e[0].z, e[1].z, e[2].z, e[3].z), sr, cr))
+			{
+				for (size_t j = 0; j < 4; ++j)
+				{
+					out[i + j] = MakeEuler(e[j]);
+				}
+				continue;
+			}
+			MATHCLASSES_COUNT_N(MakeEuler, 4);
+			MATHCLASSES_COUNT_N(Trig, 24);
+
+			const __m128 sign = _mm_set1_ps(-0.0f);
+			__m128 spsy = _mm_mul_ps(sp, sy), cpsy = _mm_mul_ps(cp, sy);
+			__m128 x0 = Simd::Round6(_mm_mul_ps(cy, cr));
+			__m128 x1 = Simd::Round6(_mm_mul_ps(cy, sr));
+			__m128 x2 = Simd::Round6(sy);
+			__m128 x3 = _mm_setzero_ps();
+			__m128 y0 = Simd::Round6(_mm_sub_ps(_mm_mul_ps(spsy, cr), _mm_mul_ps(cp, sr)));
+			__m128 y1 = Simd::Round6(_mm_add_ps(_mm_mul_ps(spsy, sr), _mm_mul_ps(cp, cr)));
+			__m128 y2 = Simd::Round6(_mm_xor_ps(_mm_mul_ps(sp, cy), sign));
+			__m128 y3 = _mm_setzero_ps();
+			__m128 z0 = Simd::Round6(_mm_xor_ps(_mm_add_ps(_mm_mul_ps(cpsy, cr), _mm_mul_ps(sp, sr)), sign));
+			__m128 z1 = Simd::Round6(_mm_xor_ps(_mm_sub_ps(_mm_mul_ps(cpsy, sr), _mm_mul_ps(sp, cr)), sign));
+			__m128 z2 = Simd::Round6(_mm_mul_ps(cp, cy));
+			__m128 z3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+			_MM_TRANSPOSE4_PS(y0, y1, y2, y3);
+			_MM_TRANSPOSE4_PS(z0, z1, z2, z3);
+
+			const __m128 w = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+			__m128 columns[4][3] = { { x0, y0, z0 }, { x1, y1, z1 }, { x2, y2, z2 }, { x3, y3, z3 } };
+			for (int j = 0; j < 4; ++j)
+			{
+				float* dst = &out[i + j].m1;
+				_mm_storeu_ps(dst, columns[j][0]);
+				_mm_storeu_ps(dst + 4, columns[j][1]);
+				_mm_storeu_ps(dst + 8, columns[j][2]);
+				_mm_storeu_ps(dst + 12, w);
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			out[i] = MakeEuler(euler[i]);
+		}
+	}
+
 	Matrix4 Matrix4::MakeScale(float x, float y, float z)
 	{
 		return Matrix4(
@@ -317,18 +514,40 @@ namespace MathClasses
 
 	std::string Matrix4::ToString() const
 	{
-		std::ostringstream oss;
-		oss << std::fixed << std::setprecision(2);
-		oss << "[" << m1 << ", " << m2 << ", " << m3 << ", " << m4 << "]\n"
-			<< "[" << m5 << ", " << m6 << ", " << m7 << ", " << m8 << "]\n"
-			<< "[" << m9 << ", " << m10 << ", " << m11 << ", " << m12 << "]\n"
-			<< "[" << m13 << ", " << m14 << ", " << m15 << ", " << m16 << "]";
-		return oss.str();
+		MATHCLASSES_COUNT(ToString);
+
+		return Format::ToString(*this);
+	}
+
+	size_t Matrix4::FormatTo(char* buffer, size_t size, int precision) const
+	{
+		int digits = precision < 0 ? 2 : precision;
+		const float values[16] = { m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16 };
+		Format::Writer out(buffer, size);
+		for (int row = 0; row < 4; ++row)
+		{
+			out.Put(row == 0 ? "[" : "]\n[");
+			for (int col = 0; col < 4; ++col)
+			{
+				if (col > 0)
+				{
+					out.Put(", ");
+				}
+				out.Put(values[row * 4 + col], std::chars_format::fixed, digits);
+			}
+		}
+		out.Put(']');
+		return out.Finish();
 	}
 
 	std::ostream& operator<<(std::ostream& os, const Matrix4& m)
 	{
-		os << m.ToString();
-		return os;
+		char buffer[256];
+		size_t length = m.FormatTo(buffer, sizeof(buffer));
+		if (length < sizeof(buffer))
+		{
+			return os.write(buffer, static_cast<std::streamsize>(length));
+		}
+		return os << m.ToString();
 	}
 }
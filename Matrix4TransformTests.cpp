@@ -115,5 +115,73 @@ namespace MathLibraryTests
 					0, 0, 4.0f, 0,
 					0, 0, 0, 1), actual);
 		}
+		// point and direction transforms of a Vector3
+		TEST_METHOD(TransformPointDirection)
+		{
+			Matrix4 m = Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f) * Matrix4::MakeRotateZ(0.5f);
+			Vector3 v(2.0f, -1.0f, 4.0f);
+			MathClasses::Vector4 point = m * MathClasses::Vector4(v.x, v.y, v.z, 1.0f);
+			MathClasses::Vector4 direction = m * MathClasses::Vector4(v.x, v.y, v.z, 0.0f);
+
+			Assert::AreEqual(Vector3(point.x, point.y, point.z), m.TransformPoint(v));
+			Assert::AreEqual(Vector3(direction.x, direction.y, direction.z), m.TransformDirection(v));
+			Assert::AreEqual(Vector3(3.0f, 1.0f, 7.0f), Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f).TransformPoint(v));
+			Assert::AreEqual(v, Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f).TransformDirection(v));
+		}
+		// perspective divide by the transformed w
+		TEST_METHOD(TransformPointProjective)
+		{
+			Matrix4 m(1, 0, 0, 0,
+				0, 1, 0, 0,
+				0, 0, 1, -1,
+				0, 0, 0, 0);
+			Vector3 actual = m.TransformPointProjective(Vector3(2.0f, 4.0f, -2.0f));
+
+			Assert::AreEqual(Vector3(1.0f, 2.0f, -1.0f), actual);
+		}
+		// SoA batches match the single transforms, including the scalar tail
+		TEST_METHOD(TransformSoA)
+		{
+			Matrix4 m = Matrix4::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f);
+			m.m4 = 0.1f;
+			float x[7], y[7], z[7], ox[7], oy[7], oz[7];
+			for (int i = 0; i < 7; ++i)
+			{
+				x[i] = 1.0f * i;
+				y[i] = -0.5f * i;
+				z[i] = 2.0f;
+			}
+
+			m.TransformPoints(x, y, z, ox, oy, oz, 7);
+			for (int i = 0; i < 7; ++i)
+			{
+				Assert::AreEqual(m.TransformPoint(Vector3(x[i], y[i], z[i])), Vector3(ox[i], oy[i], oz[i]));
+			}
+			m.TransformDirections(x, y, z, ox, oy, oz, 7);
+			for (int i = 0; i < 7; ++i)
+			{
+				Assert::AreEqual(m.TransformDirection(Vector3(x[i], y[i], z[i])), Vector3(ox[i], oy[i], oz[i]));
+			}
+			// in place
+			m.TransformPointsProjective(x, y, z, x, y, z, 7);
+			Assert::AreEqual(m.TransformPointProjective(Vector3(6.0f, -3.0f, 2.0f)), Vector3(x[6], y[6], z[6]));
+		}
+		// the batch builder matches MakeEuler, including the scalar tail and angles past its SIMD range
+		TEST_METHOD(MakeEulerArray)
+		{
+			Vector3 euler[7];
+			for (int i = 0; i < 7; ++i)
+			{
+				euler[i] = Vector3(0.7f * i - 2.0f, 1.3f - 0.4f * i, 3.0f * i);
+			}
+			euler[5].x = 1e6f;
+
+			Matrix4 out[7];
+			Matrix4::MakeEuler(euler, out, 7);
+			for (int i = 0; i < 7; ++i)
+			{
+				Assert::AreEqual(Matrix4::MakeEuler(euler[i]), out[i]);
+			}
+		}
 	};
 }
\ No newline at end of file
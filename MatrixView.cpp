@@ -0,0 +1,197 @@
+#include "MathHeaders/MatrixView.h"
+#include "MathHeaders/SimdConfig.h"
+#include <cmath>
+
+namespace MathClasses {
+	namespace {
+		inline bool Near(float a, float b, float epsilon) {
+			return std::fabs(a - b) <= epsilon;
+		}
+
+#if MATHCLASSES_SSE2
+		// column c of the view as a register, in column-vector terms
+		inline __m128 Column(const Matrix4View& m, int c) {
+			if (m.order == MatrixOrder::ColumnMajor) {
+				return _mm_loadu_ps(m.data + c * m.stride);
+			}
+			return _mm_set_ps(m.data[3 * m.stride + c], m.data[2 * m.stride + c], m.data[m.stride + c], m.data[c]);
+		}
+#endif
+	}
+
+	float Vector3View::Dot(Vector3View other) const {
+		return X() * other.X() + Y() * other.Y() + Z() * other.Z();
+	}
+
+	Vector3 Vector3View::Cross(Vector3View other) const {
+		return ToVector3().Cross(other.ToVector3());
+	}
+
+	float Vector3View::Magnitude() const {
+		return std::sqrt(Dot(*this));
+	}
+
+	bool Vector3View::Equals(Vector3View other, float epsilon) const {
+		return Near(X(), other.X(), epsilon) && Near(Y(), other.Y(), epsilon) && Near(Z(), other.Z(), epsilon);
+	}
+
+	float Vector4View::Dot(Vector4View other) const {
+		return X() * other.X() + Y() * other.Y() + Z() * other.Z() + W() * other.W();
+	}
+
+	float Vector4View::Magnitude() const {
+		return std::sqrt(Dot(*this));
+	}
+
+	bool Vector4View::Equals(Vector4View other, float epsilon) const {
+		return Near(X(), other.X(), epsilon) && Near(Y(), other.Y(), epsilon) &&
+			Near(Z(), other.Z(), epsilon) && Near(W(), other.W(), epsilon);
+	}
+
+	Matrix4 Matrix4View::ToMatrix4() const {
+		float m[16];
+		for (int c = 0; c < 4; ++c) {
+			for (int r = 0; r < 4; ++r) {
+				m[c * 4 + r] = At(r, c);
+			}
+		}
+		return Matrix4(m);
+	}
+
+	// sums run in the same order as Matrix4::operator*, so results are bit-identical
+	Matrix4 Matrix4View::operator*(const Matrix4View& rhs) const {
+#if MATHCLASSES_SSE2
+		// stored straight into the result, copying through a float array stalls store forwarding
+		Matrix4 result;
+		float* m = &result.m1;
+		__m128 a0 = Column(*this, 0), a1 = Column(*this, 1), a2 = Column(*this, 2), a3 = Column(*this, 3);
+		for (int c = 0; c < 4; ++c) {
+			__m128 b = Column(rhs, c);
+			__m128 sum = _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)), a0);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)), a1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), a2));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)), a3));
+			_mm_storeu_ps(m + c * 4, sum);
+		}
+		return result;
+#else
+		float m[16];
+		for (int c = 0; c < 4; ++c) {
+			for (int r = 0; r < 4; ++r) {
+				m[c * 4 + r] = rhs.At(0, c) * At(r, 0) + rhs.At(1, c) * At(r, 1) + rhs.At(2, c) * At(r, 2) + rhs.At(3, c) * At(r, 3);
+			}
+		}
+		return Matrix4(m);
+#endif
+	}
+
+	Vector4 Matrix4View::operator*(const Vector4& rhs) const {
+		return *this * Vector4View(rhs);
+	}
+
+	Vector4 Matrix4View::operator*(Vector4View rhs) const {
+		float x = rhs.X(), y = rhs.Y(), z = rhs.Z(), w = rhs.W();
+		return Vector4(
+			x * At(0, 0) + y * At(0, 1) + z * At(0, 2) + w * At(0, 3),
+			x * At(1, 0) + y * At(1, 1) + z * At(1, 2) + w * At(1, 3),
+			x * At(2, 0) + y * At(2, 1) + z * At(2, 2) + w * At(2, 3),
+			x * At(3, 0) + y * At(3, 1) + z * At(3, 2) + w * At(3, 3)
+		);
+	}
+
+	bool Matrix4View::operator==(Matrix4View rhs) const {
+		for (int c = 0; c < 4; ++c) {
+			for (int r = 0; r < 4; ++r) {
+				if (At(r, c) != rhs.At(r, c)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Matrix4View::Equals(Matrix4View other, float epsilon) const {
+		for (int c = 0; c < 4; ++c) {
+			for (int r = 0; r < 4; ++r) {
+				if (!Near(At(r, c), other.At(r, c), epsilon)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	Matrix3 Matrix3View::ToMatrix3() const {
+		float m[9];
+		for (int c = 0; c < 3; ++c) {
+			for (int r = 0; r < 3; ++r) {
+				m[c * 3 + r] = At(r, c);
+			}
+		}
+		return Matrix3(m);
+	}
+
+	// same summation order as Matrix3::operator*
+	Matrix3 Matrix3View::operator*(const Matrix3View& rhs) const {
+		float m[9];
+		for (int c = 0; c < 3; ++c) {
+			for (int r = 0; r < 3; ++r) {
+				m[c * 3 + r] = At(r, 0) * rhs.At(0, c) + At(r, 1) * rhs.At(1, c) + At(r, 2) * rhs.At(2, c);
+			}
+		}
+		return Matrix3(m);
+	}
+
+	Vector3 Matrix3View::operator*(const Vector3& rhs) const {
+		return *this * Vector3View(rhs);
+	}
+
+	Vector3 Matrix3View::operator*(Vector3View rhs) const {
+		float x = rhs.X(), y = rhs.Y(), z = rhs.Z();
+		return Vector3(
+			At(0, 0) * x + At(0, 1) * y + At(0, 2) * z,
+			At(1, 0) * x + At(1, 1) * y + At(1, 2) * z,
+			At(2, 0) * x + At(2, 1) * y + At(2, 2) * z
+		);
+	}
+
+	bool Matrix3View::operator==(Matrix3View rhs) const {
+		for (int c = 0; c < 3; ++c) {
+			for (int r = 0; r < 3; ++r) {
+				if (At(r, c) != rhs.At(r, c)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Matrix3View::Equals(Matrix3View other, float epsilon) const {
+		for (int c = 0; c < 3; ++c) {
+			for (int r = 0; r < 3; ++r) {
+				if (!Near(At(r, c), other.At(r, c), epsilon)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void Store(const Matrix4& m, float* out, MatrixOrder order, size_t stride) {
+		Matrix4View source(m);
+		for (int c = 0; c < 4; ++c) {
+			for (int r = 0; r < 4; ++r) {
+				out[order == MatrixOrder::ColumnMajor ? c * stride + r : r * stride + c] = source.At(r, c);
+			}
+		}
+	}
+
+	void Store(const Matrix3& m, float* out, MatrixOrder order, size_t stride) {
+		Matrix3View source(m);
+		for (int c = 0; c < 3; ++c) {
+			for (int r = 0; r < 3; ++r) {
+				out[order == MatrixOrder::ColumnMajor ? c * stride + r : r * stride + c] = source.At(r, c);
+			}
+		}
+	}
+}
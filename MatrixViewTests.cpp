@@ -0,0 +1,89 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/MatrixView.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(MatrixViewTests)
+	{
+	public:
+		// a column-major view reads m1..m16 order and multiplies exactly like Matrix4
+		TEST_METHOD(Matrix4ColumnMajor)
+		{
+			Matrix4 a = Matrix4::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix4::MakeTranslation(1.f, 2.f, 3.f);
+			Matrix4 b = Matrix4::MakeScale(2.f, 0.5f, 4.f) * Matrix4::MakeRotateY(0.7f);
+			float buffer[16];
+			Store(a, buffer);
+
+			Matrix4View view(buffer);
+			Assert::AreEqual(a, view.ToMatrix4());
+			Assert::AreEqual(a.m15, view.At(2, 3));
+			Assert::AreEqual(a * b, view * Matrix4View(b));
+			Assert::AreEqual(b * a, Matrix4View(b) * view);
+
+			Vector4 v(1.f, -2.f, 0.5f, 1.f);
+			Assert::AreEqual(a * v, view * v);
+		}
+
+		// row-major data with padded rows gives the same matrix
+		TEST_METHOD(Matrix4RowMajorStride)
+		{
+			Matrix4 a = Matrix4::MakeEuler(0.1f, 0.2f, 0.3f) * Matrix4::MakeTranslation(-4.f, 5.f, 6.f);
+			float buffer[4 * 5] = {};
+			Store(a, buffer, MatrixOrder::RowMajor, 5);
+			Assert::AreEqual(a.m13, buffer[3]);
+
+			Matrix4View view(buffer, MatrixOrder::RowMajor, 5);
+			Assert::IsTrue(view == Matrix4View(a));
+			Assert::AreEqual(a * a, view * view);
+			Assert::AreEqual(a.m5, view.Transposed().At(1, 0));
+			Assert::IsFalse(view == view.Transposed());
+
+			float nudged[16];
+			Store(a, nudged);
+			nudged[5] += 1e-6f;
+			Assert::IsTrue(view.Equals(Matrix4View(nudged)));
+			Assert::IsFalse(view.Equals(Matrix4View(nudged), 1e-8f));
+		}
+
+		TEST_METHOD(Matrix3Views)
+		{
+			Matrix3 a = Matrix3::MakeRotateZ(0.5f) * Matrix3::MakeScale(2.f, 3.f, 1.f);
+			Matrix3 b = Matrix3::MakeTranslation(1.f, -1.f);
+			float rows[12];
+			Store(a, rows, MatrixOrder::RowMajor, 4);
+
+			Matrix3View view(rows, MatrixOrder::RowMajor, 4);
+			Assert::AreEqual(a, view.ToMatrix3());
+			Assert::AreEqual(a * b, view * Matrix3View(b));
+			Vector3 v(1.f, 2.f, 3.f);
+			Assert::AreEqual(a * v, view * v);
+		}
+
+		// a vector spread over SoA planes
+		TEST_METHOD(VectorViews)
+		{
+			const float planes[3 * 4] = {
+				1.f, 10.f, 100.f, 1000.f,
+				2.f, 20.f, 200.f, 2000.f,
+				3.f, 30.f, 300.f, 3000.f
+			};
+			Vector3View second(planes + 1, 4);
+			Assert::AreEqual(Vector3(10.f, 20.f, 30.f), second.ToVector3());
+
+			Vector3 other(0.f, 1.f, 0.f);
+			Assert::AreEqual(20.f, second.Dot(other), MAX_FLOAT_DELTA);
+			Assert::AreEqual(Vector3(10.f, 20.f, 30.f).Cross(other), second.Cross(other));
+			Assert::IsTrue(second.Equals(Vector3(10.f, 20.f, 30.f)));
+
+			Vector4View first(planes);
+			Assert::AreEqual(Vector4(1.f, 10.f, 100.f, 1000.f), first.ToVector4());
+			Assert::AreEqual(Vector4(1.f, 10.f, 100.f, 1000.f).Magnitude(), first.Magnitude(), MAX_FLOAT_DELTA);
+		}
+	};
+}
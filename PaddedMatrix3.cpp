@@ -0,0 +1,130 @@
+#include "MathHeaders/PaddedMatrix3.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
+
+namespace MathClasses {
+	namespace {
+#if MATHCLASSES_SSE2
+		// a * rhs for one column of rhs, summed in Matrix3::operator*'s order
+		inline __m128 Column(__m128 a0, __m128 a1, __m128 a2, const float* rhs) {
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(rhs[0])), _mm_mul_ps(a1, _mm_set1_ps(rhs[1]))),
+				_mm_mul_ps(a2, _mm_set1_ps(rhs[2])));
+		}
+#endif
+
+		inline void Multiply(const PaddedMatrix3& a, const PaddedMatrix3& b, PaddedMatrix3& out) {
+#if MATHCLASSES_SSE2
+			__m128 a0 = _mm_load_ps(a.m), a1 = _mm_load_ps(a.m + 4), a2 = _mm_load_ps(a.m + 8);
+			__m128 r0 = Column(a0, a1, a2, b.m), r1 = Column(a0, a1, a2, b.m + 4), r2 = Column(a0, a1, a2, b.m + 8);
+			_mm_store_ps(out.m, r0);
+			_mm_store_ps(out.m + 4, r1);
+			_mm_store_ps(out.m + 8, r2);
+#else
+			float r[12] = {};
+			for (int c = 0; c < 3; ++c) {
+				for (int row = 0; row < 3; ++row) {
+					r[c * 4 + row] = a.m[row] * b.m[c * 4] + a.m[4 + row] * b.m[c * 4 + 1] + a.m[8 + row] * b.m[c * 4 + 2];
+				}
+			}
+			std::copy(r, r + 12, out.m);
+#endif
+		}
+	}
+
+	PaddedMatrix3::PaddedMatrix3() : m() {}
+
+	PaddedMatrix3::PaddedMatrix3(const Matrix3& packed)
+		: m{ packed.m1, packed.m2, packed.m3, 0, packed.m4, packed.m5, packed.m6, 0, packed.m7, packed.m8, packed.m9, 0 } {}
+
+	Matrix3 PaddedMatrix3::ToMatrix3() const {
+		return Matrix3(m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]);
+	}
+
+	PaddedMatrix3 PaddedMatrix3::operator*(const PaddedMatrix3& rhs) const {
+		PaddedMatrix3 result;
+		Multiply(*this, rhs, result);
+		return result;
+	}
+
+	Vector3 PaddedMatrix3::operator*(const Vector3& rhs) const {
+#if MATHCLASSES_SSE2
+		__m128 r = Column(_mm_load_ps(m), _mm_load_ps(m + 4), _mm_load_ps(m + 8), &rhs.x);
+		alignas(16) float v[4];
+		_mm_store_ps(v, r);
+		return Vector3(v[0], v[1], v[2]);
+#else
+		return Vector3(
+			m[0] * rhs.x + m[4] * rhs.y + m[8] * rhs.z,
+			m[1] * rhs.x + m[5] * rhs.y + m[9] * rhs.z,
+			m[2] * rhs.x + m[6] * rhs.y + m[10] * rhs.z
+		);
+#endif
+	}
+
+	PaddedMatrix3 PaddedMatrix3::Transposed() const {
+		PaddedMatrix3 result;
+#if MATHCLASSES_SSE2
+		__m128 c0 = _mm_load_ps(m), c1 = _mm_load_ps(m + 4), c2 = _mm_load_ps(m + 8), c3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		// the transpose moves the padding into the last row; zero it again in each column
+		__m128 keep = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		_mm_store_ps(result.m, _mm_and_ps(c0, keep));
+		_mm_store_ps(result.m + 4, _mm_and_ps(c1, keep));
+		_mm_store_ps(result.m + 8, _mm_and_ps(c2, keep));
+#else
+		for (int c = 0; c < 3; ++c) {
+			for (int row = 0; row < 3; ++row) {
+				result.m[c * 4 + row] = m[row * 4 + c];
+			}
+		}
+#endif
+		return result;
+	}
+
+	bool PaddedMatrix3::operator==(const PaddedMatrix3& rhs) const {
+		for (int c = 0; c < 3; ++c) {
+			for (int row = 0; row < 3; ++row) {
+				if (m[c * 4 + row] != rhs.m[c * 4 + row]) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void PaddedMatrix3Array::Assign(const Matrix3* packed, size_t count) {
+		items.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			items[i] = PaddedMatrix3(packed[i]);
+		}
+	}
+
+	void PaddedMatrix3Array::CopyTo(Matrix3* out) const {
+		for (size_t i = 0; i < items.size(); ++i) {
+			out[i] = items[i].ToMatrix3();
+		}
+	}
+
+	void PaddedMatrix3Array::Multiply(const PaddedMatrix3& rhs, PaddedMatrix3Array& out) const {
+		// rhs may be an element of out, which the loop (or the resize) would change under it
+		const PaddedMatrix3 b = rhs;
+		out.items.resize(items.size());
+		for (size_t i = 0; i < items.size(); ++i) {
+			MathClasses::Multiply(items[i], b, out.items[i]);
+		}
+	}
+
+	void PaddedMatrix3Array::Multiply(const PaddedMatrix3Array& rhs, PaddedMatrix3Array& out) const {
+		size_t count = std::min(items.size(), rhs.items.size());
+		out.items.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			MathClasses::Multiply(items[i], rhs.items[i], out.items[i]);
+		}
+	}
+
+	void PaddedMatrix3Array::Transform(const Vector3* vectors, Vector3* out) const {
+		for (size_t i = 0; i < items.size(); ++i) {
+			out[i] = items[i] * vectors[i];
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/PaddedMatrix3.h"
+#include <cstdint>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(PaddedMatrix3Tests)
+	{
+	public:
+		TEST_METHOD(Layout)
+		{
+			Matrix3 packed(1, 2, 3, 4, 5, 6, 7, 8, 9);
+			PaddedMatrix3 padded(packed);
+			Assert::AreEqual(size_t(48), sizeof(PaddedMatrix3));
+			Assert::AreEqual(size_t(0), reinterpret_cast<uintptr_t>(&padded) % 16);
+			Assert::AreEqual(4.f, padded.m[4]);
+			Assert::AreEqual(0.f, padded.m[7]);
+			Assert::AreEqual(8.f, padded.At(1, 2));
+			Assert::AreEqual(packed, padded.ToMatrix3());
+		}
+
+		// the padded operators give exactly the packed results
+		TEST_METHOD(Operators)
+		{
+			Matrix3 a = Matrix3::MakeEuler(0.3f, -1.1f, 2.0f) * Matrix3::MakeScale(1.5f, 2.0f, 0.5f);
+			Matrix3 b = Matrix3::MakeTranslation(3.f, -4.f) * Matrix3::MakeRotateZ(0.8f);
+			Vector3 v(1.f, -2.f, 0.5f);
+			PaddedMatrix3 pa(a), pb(b);
+
+			Assert::AreEqual(a * b, (pa * pb).ToMatrix3());
+			Assert::AreEqual(b * a, (pb * pa).ToMatrix3());
+			Assert::AreEqual(a * v, pa * v);
+			Assert::AreEqual(a.Transposed(), pa.Transposed().ToMatrix3());
+			Assert::AreEqual(0.f, pa.Transposed().m[11]);
+			Assert::IsTrue(pa.Transposed().Transposed() == pa);
+			Assert::IsTrue(pa != pb);
+		}
+
+		TEST_METHOD(Array)
+		{
+			Matrix3 packed[5];
+			Vector3 vectors[5], transformed[5];
+			for (int i = 0; i < 5; ++i)
+			{
+				packed[i] = Matrix3::MakeRotateZ(0.2f * i) * Matrix3::MakeScale(1.f + i, 2.f);
+				vectors[i] = Vector3(1.f * i, 2.f, 1.f);
+			}
+			Matrix3 rhs = Matrix3::MakeTranslation(1.f, 2.f);
+
+			PaddedMatrix3Array array(packed, 5);
+			Assert::AreEqual(size_t(5), array.Size());
+			array.Transform(vectors, transformed);
+
+			PaddedMatrix3Array products;
+			array.Multiply(PaddedMatrix3(rhs), products);
+			array.Multiply(array, array);
+			Matrix3 back[5];
+			products.CopyTo(back);
+			for (int i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(packed[i] * rhs, back[i]);
+				Assert::AreEqual(packed[i] * vectors[i], transformed[i]);
+				Assert::AreEqual(packed[i] * packed[i], array[i].ToMatrix3());
+			}
+
+			// in place against one of its own elements
+			PaddedMatrix3Array scaled(packed, 5);
+			scaled.Multiply(scaled[2], scaled);
+			for (int i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(packed[i] * packed[2], scaled[i].ToMatrix3());
+			}
+		}
+	};
+}
@@ -0,0 +1,258 @@
+#include "MathHeaders/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MathClasses {
+	namespace Parallel {
+		namespace {
+			// ranges per thread that For aims for, so a thread finishing early has something to steal
+			const size_t RangesPerThread = 4;
+
+			// set while a thread runs chunks of a loop; nested loops then run inline
+			thread_local bool insideLoop = false;
+
+			// sets insideLoop for a thread's share of a loop and puts it back however the share ends
+			struct LoopScope {
+				bool wasInside;
+				LoopScope() : wasInside(insideLoop) { insideLoop = true; }
+				~LoopScope() { insideLoop = wasInside; }
+			};
+
+			unsigned HardwareThreads() {
+				unsigned n = std::thread::hardware_concurrency();
+				return n > 0 ? n : 1;
+			}
+
+			// Runs chunk(0) .. chunk(count - 1) on the calling thread and threads - 1 workers. Every
+			// thread starts with a contiguous share of the chunk indices and takes them from the front;
+			// once its share is gone it steals the back half of another thread's. A chunk that throws,
+			// on any thread, makes the others skip what is left; the first exception is rethrown on
+			// the calling thread after every thread is done with the job.
+			class Pool {
+			public:
+				explicit Pool(unsigned threadCount) : slots(threadCount) {
+					workers.reserve(threadCount - 1);
+					for (unsigned i = 1; i < threadCount; ++i) {
+						workers.emplace_back(&Pool::WorkerLoop, this, i);
+					}
+				}
+
+				~Pool() {
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						stop = true;
+					}
+					wake.notify_all();
+					for (std::thread& t : workers) {
+						t.join();
+					}
+				}
+
+				unsigned ThreadCount() const {
+					return static_cast<unsigned>(slots.size());
+				}
+
+				void Run(size_t count, const std::function<void(size_t)>& chunk) {
+					size_t threads = slots.size();
+					for (size_t i = 0; i < threads; ++i) {
+						slots[i].range.store(Pack(count * i / threads, count * (i + 1) / threads), std::memory_order_relaxed);
+					}
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						job = &chunk;
+						active = workers.size();
+						failed.store(false, std::memory_order_relaxed);
+						++generation;
+					}
+					wake.notify_all();
+
+					Work(0);
+
+					// every thread has left Work only once no chunk is unclaimed, and a thread still
+					// running one has not left, so this returns after the last chunk is done
+					std::unique_lock<std::mutex> lock(mutex);
+					done.wait(lock, [this] { return active == 0; });
+					job = nullptr;
+					if (error) {
+						std::exception_ptr thrown = error;
+						error = nullptr;
+						lock.unlock();
+						std::rethrow_exception(thrown);
+					}
+				}
+
+			private:
+				// a thread's remaining chunks [begin, end) in one word, so the owner taking the front
+				// and a thief taking the back half agree through a single compare-exchange
+				struct alignas(64) Slot {
+					std::atomic<uint64_t> range{ 0 };
+				};
+
+				static uint64_t Pack(size_t begin, size_t end) {
+					return static_cast<uint64_t>(begin) << 32 | static_cast<uint64_t>(end);
+				}
+
+				bool Pop(size_t self, size_t& index) {
+					std::atomic<uint64_t>& range = slots[self].range;
+					uint64_t r = range.load(std::memory_order_acquire);
+					for (;;) {
+						size_t begin = static_cast<size_t>(r >> 32), end = static_cast<size_t>(r & 0xffffffffu);
+						if (begin >= end) {
+							return false;
+						}
+						if (range.compare_exchange_weak(r, Pack(begin + 1, end), std::memory_order_acq_rel)) {
+							index = begin;
+							return true;
+						}
+					}
+				}
+
+				// moves the back half of the first non-empty share after self's into self's slot
+				bool Steal(size_t self) {
+					size_t threads = slots.size();
+					for (size_t step = 1; step < threads; ++step) {
+						std::atomic<uint64_t>& victim = slots[(self + step) % threads].range;
+						uint64_t r = victim.load(std::memory_order_acquire);
+						for (;;) {
+							size_t begin = static_cast<size_t>(r >> 32), end = static_cast<size_t>(r & 0xffffffffu);
+							if (begin >= end) {
+								break;
+							}
+							size_t middle = begin + (end - begin) / 2;
+							if (victim.compare_exchange_weak(r, Pack(begin, middle), std::memory_order_acq_rel)) {
+								slots[self].range.store(Pack(middle, end), std::memory_order_release);
+								return true;
+							}
+						}
+					}
+					return false;
+				}
+
+				void Work(size_t self) {
+					LoopScope scope;
+					size_t index;
+					for (;;) {
+						if (Pop(self, index)) {
+							// after a failure the remaining chunks are still claimed, just not run
+							if (failed.load(std::memory_order_relaxed)) {
+								continue;
+							}
+							try {
+								(*job)(index);
+							}
+							catch (...) {
+								Fail(std::current_exception());
+							}
+						}
+						else if (!Steal(self)) {
+							break;
+						}
+					}
+				}
+
+				void Fail(std::exception_ptr thrown) {
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!error) {
+						error = thrown;
+					}
+					failed.store(true, std::memory_order_relaxed);
+				}
+
+				void WorkerLoop(size_t self) {
+					uint64_t seen = 0;
+					for (;;) {
+						{
+							std::unique_lock<std::mutex> lock(mutex);
+							wake.wait(lock, [&] { return stop || generation != seen; });
+							if (stop) {
+								return;
+							}
+							seen = generation;
+						}
+						Work(self);
+						std::lock_guard<std::mutex> lock(mutex);
+						if (--active == 0) {
+							done.notify_one();
+						}
+					}
+				}
+
+				std::vector<Slot> slots;
+				std::vector<std::thread> workers;
+				std::mutex mutex;
+				std::condition_variable wake;
+				std::condition_variable done;
+				const std::function<void(size_t)>* job = nullptr;
+				std::exception_ptr error;
+				std::atomic<bool> failed{ false };
+				uint64_t generation = 0;
+				size_t active = 0;
+				bool stop = false;
+			};
+
+			// one loop at a time runs on the pool; the lock also covers resizing it
+			std::mutex poolMutex;
+			std::unique_ptr<Pool> pool;
+			std::atomic<unsigned> requestedThreads{ 0 };
+
+			// chunk index's range of the even split ForChunks promises
+			inline void ChunkRange(size_t count, size_t chunkCount, size_t chunk, size_t& begin, size_t& end) {
+				size_t step = count / chunkCount, extra = count % chunkCount;
+				begin = chunk * step + std::min(chunk, extra);
+				end = begin + step + (chunk < extra ? 1 : 0);
+			}
+		}
+
+		unsigned WorkerCount() {
+			unsigned n = requestedThreads.load(std::memory_order_relaxed);
+			return n > 0 ? n : HardwareThreads();
+		}
+
+		void SetWorkerCount(unsigned count) {
+			std::lock_guard<std::mutex> lock(poolMutex);
+			requestedThreads.store(count, std::memory_order_relaxed);
+			if (pool && pool->ThreadCount() != WorkerCount()) {
+				pool.reset();
+			}
+		}
+
+		void ForChunks(size_t count, size_t chunkCount, const std::function<void(size_t, size_t, size_t)>& fn) {
+			if (count == 0) {
+				return;
+			}
+			// the packed steal ranges hold 32-bit chunk indices
+			chunkCount = std::max<size_t>(1, std::min({ chunkCount, count, size_t(0xffffffffu) }));
+			if (chunkCount == 1 || insideLoop || WorkerCount() == 1) {
+				for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+					size_t begin, end;
+					ChunkRange(count, chunkCount, chunk, begin, end);
+					fn(chunk, begin, end);
+				}
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(poolMutex);
+			if (!pool) {
+				pool.reset(new Pool(WorkerCount()));
+			}
+			pool->Run(chunkCount, [&](size_t chunk) {
+				size_t begin, end;
+				ChunkRange(count, chunkCount, chunk, begin, end);
+				fn(chunk, begin, end);
+			});
+		}
+
+		void For(size_t count, size_t minGrain, const std::function<void(size_t, size_t)>& fn) {
+			size_t grain = minGrain > 0 ? minGrain : AutoGrain;
+			size_t chunks = std::min<size_t>(WorkerCount() * RangesPerThread, count / grain);
+			ForChunks(count, chunks, [&fn](size_t, size_t begin, size_t end) { fn(begin, end); });
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#include "CppUnitTest.h"
+
+#include "MathHeaders/Parallel.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ParallelTests)
+	{
+	public:
+		// every chunk runs exactly once over the even split, whatever thread takes it
+		TEST_METHOD(ForChunksCoversRange)
+		{
+			Parallel::SetWorkerCount(4);
+			const size_t count = 100003, chunks = 37;
+			std::vector<int> hits(count, 0);
+			std::vector<int> chunkHits(chunks, 0);
+			std::vector<size_t> chunkBegins(chunks, 0);
+			// workers only record what they saw; the asserts run on the test thread
+			Parallel::ForChunks(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+				++chunkHits[chunk];
+				chunkBegins[chunk] = begin;
+				for (size_t i = begin; i < end; ++i)
+				{
+					++hits[i];
+				}
+			});
+			Parallel::SetWorkerCount(0);
+
+			for (size_t i = 0; i < chunks; ++i)
+			{
+				Assert::AreEqual(1, chunkHits[i]);
+				Assert::AreEqual(i * (count / chunks) + (i < count % chunks ? i : count % chunks), chunkBegins[i]);
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(1, hits[i]);
+			}
+		}
+		// the pool is reused across calls and loops started from inside a loop run inline
+		TEST_METHOD(ForNestedAndRepeated)
+		{
+			Parallel::SetWorkerCount(3);
+			Assert::AreEqual(3u, Parallel::WorkerCount());
+			for (int repeat = 0; repeat < 50; ++repeat)
+			{
+				std::atomic<size_t> total(0);
+				Parallel::For(64, 1, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i)
+					{
+						Parallel::For(1000, 0, [&](size_t innerBegin, size_t innerEnd) {
+							total += innerEnd - innerBegin;
+						});
+					}
+				});
+				Assert::AreEqual(size_t(64000), total.load());
+			}
+			Parallel::SetWorkerCount(0);
+		}
+		// a throwing chunk, on the calling thread or a worker, comes back out of ForChunks and
+		// leaves the pool running loops in parallel afterwards
+		TEST_METHOD(ForChunksRethrows)
+		{
+			Parallel::SetWorkerCount(4);
+			const size_t chunks = 16;
+			for (size_t throwing : { size_t(0), chunks - 1 })
+			{
+				bool caught = false;
+				try
+				{
+					Parallel::ForChunks(chunks, chunks, [&](size_t chunk, size_t, size_t) {
+						if (chunk == throwing)
+						{
+							throw std::runtime_error("chunk failed");
+						}
+					});
+				}
+				catch (const std::runtime_error&)
+				{
+					caught = true;
+				}
+				Assert::IsTrue(caught);
+			}
+
+			// chunk 0 is the calling thread's, so it threw there; a loop still marked as nested
+			// would now run every chunk on this thread
+			std::vector<std::thread::id> threads(chunks);
+			Parallel::ForChunks(chunks, chunks, [&](size_t chunk, size_t, size_t) {
+				threads[chunk] = std::this_thread::get_id();
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			});
+			Parallel::SetWorkerCount(0);
+
+			bool otherThread = false;
+			for (const std::thread::id& id : threads)
+			{
+				otherThread = otherThread || id != std::this_thread::get_id();
+			}
+			Assert::IsTrue(otherThread);
+		}
+	};
+}
@@ -0,0 +1,174 @@
+#include "MathHeaders/Parse.h"
+#include <charconv>
+
+namespace MathClasses {
+	namespace Parse {
+		namespace {
+			inline bool IsSpace(char c) {
+				return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+			}
+
+			inline const char* SkipSpace(const char* p, const char* last) {
+				while (p < last && IsSpace(*p)) {
+					++p;
+				}
+				return p;
+			}
+
+			// separators between values and between matrix rows
+			inline const char* SkipSeparators(const char* p, const char* last) {
+				while (p < last && (IsSpace(*p) || *p == ',')) {
+					++p;
+				}
+				return p;
+			}
+
+			inline const char* Expect(const char* p, const char* last, char c) {
+				p = SkipSpace(p, last);
+				return p < last && *p == c ? p + 1 : nullptr;
+			}
+
+			// count numbers separated by commas, between open and close
+			const char* Numbers(const char* p, const char* last, char open, char close, float* out, int count) {
+				p = Expect(p, last, open);
+				for (int i = 0; p && i < count; ++i) {
+					if (i > 0) {
+						p = Expect(p, last, ',');
+						if (!p) {
+							return nullptr;
+						}
+					}
+					p = SkipSpace(p, last);
+					std::from_chars_result result = std::from_chars(p, last, out[i]);
+					if (result.ec == std::errc::result_out_of_range) {
+						// leaves out[i] untouched; going through double gives the float overflow/underflow
+						double wide = 0;
+						result = std::from_chars(p, last, wide);
+						out[i] = static_cast<float>(wide);
+					}
+					if (result.ec != std::errc()) {
+						return nullptr;
+					}
+					p = result.ptr;
+				}
+				return p ? Expect(p, last, close) : nullptr;
+			}
+
+			// rows of "[a, b, ...]", optionally separated by commas as Matrix3 writes them
+			const char* Rows(const char* p, const char* last, float* out, int rows, int cols) {
+				for (int r = 0; p && r < rows; ++r) {
+					if (r > 0) {
+						p = SkipSeparators(p, last);
+					}
+					p = Numbers(p, last, '[', ']', out + r * cols, cols);
+				}
+				return p;
+			}
+
+			inline int HexDigit(char c) {
+				if (c >= '0' && c <= '9') return c - '0';
+				if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+				if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+				return -1;
+			}
+
+			template <typename T>
+			size_t ManyOf(const char* first, const char* last, T* out, size_t capacity, const char** stop) {
+				size_t count = 0;
+				const char* p = SkipSeparators(first, last);
+				while (count < capacity && p < last) {
+					const char* next = Value(p, last, out[count]);
+					if (!next) {
+						break;
+					}
+					++count;
+					p = SkipSeparators(next, last);
+				}
+				if (stop) {
+					*stop = p;
+				}
+				return count;
+			}
+		}
+
+		const char* Value(const char* first, const char* last, Vector3& out) {
+			float v[3];
+			const char* p = Numbers(first, last, '(', ')', v, 3);
+			if (p) {
+				out = Vector3(v[0], v[1], v[2]);
+			}
+			return p;
+		}
+
+		const char* Value(const char* first, const char* last, Vector4& out) {
+			float v[4];
+			const char* p = Numbers(first, last, '(', ')', v, 4);
+			if (p) {
+				out = Vector4(v[0], v[1], v[2], v[3]);
+			}
+			return p;
+		}
+
+		const char* Value(const char* first, const char* last, Matrix3& out) {
+			float m[9];
+			const char* p = Rows(first, last, m, 3, 3);
+			if (p) {
+				out = Matrix3(m);
+			}
+			return p;
+		}
+
+		const char* Value(const char* first, const char* last, Matrix4& out) {
+			float m[16];
+			const char* p = Rows(first, last, m, 4, 4);
+			if (p) {
+				out = Matrix4(m);
+			}
+			return p;
+		}
+
+		const char* Value(const char* first, const char* last, Colour& out) {
+			const char* p = Expect(first, last, '#');
+			if (!p) {
+				return nullptr;
+			}
+			uint32_t value = 0;
+			int digits = 0;
+			for (; digits < 8 && p < last; ++digits, ++p) {
+				int d = HexDigit(*p);
+				if (d < 0) {
+					break;
+				}
+				value = (value << 4) | static_cast<uint32_t>(d);
+			}
+			if (digits == 6) {
+				value = (value << 8) | 0xff;
+			}
+			else if (digits != 8) {
+				return nullptr;
+			}
+			out.colour = value;
+			return p;
+		}
+
+		size_t Many(const char* first, const char* last, Vector3* out, size_t capacity, const char** stop) {
+			return ManyOf(first, last, out, capacity, stop);
+		}
+
+		size_t Many(const char* first, const char* last, Vector4* out, size_t capacity, const char** stop) {
+			return ManyOf(first, last, out, capacity, stop);
+		}
+
+		size_t Many(const char* first, const char* last, Matrix3* out, size_t capacity, const char** stop) {
+			return ManyOf(first, last, out, capacity, stop);
+		}
+
+		size_t Many(const char* first, const char* last, Matrix4* out, size_t capacity, const char** stop) {
+			return ManyOf(first, last, out, capacity, stop);
+		}
+
+		size_t Many(const char* first, const char* last, Colour* out, size_t capacity, const char** stop) {
+			return ManyOf(first, last, out, capacity, stop);
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Parse.h"
+#include <cstring>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Vector3;
+using ::MathClasses::Vector4;
+using ::MathClasses::Matrix3;
+using ::MathClasses::Matrix4;
+using ::MathClasses::Colour;
+namespace Parse = ::MathClasses::Parse;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ParseTests)
+	{
+	public:
+		// whatever ToString writes parses back to the printed values
+		TEST_METHOD(RoundTripToString)
+		{
+			Vector3 v3(1.5f, -2.25f, 1000.f), r3;
+			std::string text = v3.ToString();
+			Assert::IsTrue(Parse::Value(text.data(), text.data() + text.size(), r3) == text.data() + text.size());
+			Assert::AreEqual(v3, r3);
+
+			Vector4 v4(0.125f, 2.f, -3.f, 1.f), r4;
+			text = v4.ToString();
+			Assert::IsNotNull(Parse::Value(text.data(), text.data() + text.size(), r4));
+			Assert::AreEqual(v4, r4);
+
+			Matrix3 m3 = Matrix3::MakeScale(0.5f, 2.f, 1.f) * Matrix3::MakeTranslation(4.f, -8.f), r3m;
+			text = m3.ToString();
+			Assert::IsNotNull(Parse::Value(text.data(), text.data() + text.size(), r3m));
+			Assert::AreEqual(m3, r3m);
+
+			Matrix4 m4 = Matrix4::MakeTranslation(1.25f, -2.5f, 3.75f), r4m;
+			text = m4.ToString();
+			Assert::IsNotNull(Parse::Value(text.data(), text.data() + text.size(), r4m));
+			Assert::AreEqual(m4, r4m);
+
+			Colour c(255, 128, 0, 192), rc;
+			text = c.ToString();
+			Assert::IsNotNull(Parse::Value(text.data(), text.data() + text.size(), rc));
+			Assert::AreEqual(c, rc);
+		}
+
+		// values split by newlines or commas, stopping at the first malformed entry
+		TEST_METHOD(Many)
+		{
+			const char* text = "(1, 2, 3)\n(4.5, -5, 6e2), (nan, 0, 0) (7, 8)";
+			Vector3 out[8];
+			const char* stop = nullptr;
+			size_t count = Parse::Many(text, text + std::strlen(text), out, 8, &stop);
+			Assert::AreEqual(size_t(3), count);
+			Assert::AreEqual(Vector3(4.5f, -5.f, 600.f), out[1]);
+			Assert::IsTrue(out[2].x != out[2].x);
+			Assert::AreEqual("(7, 8)", stop);
+
+			// capacity limits the count, stop points at the next value
+			count = Parse::Many(text, text + std::strlen(text), out, 1, &stop);
+			Assert::AreEqual(size_t(1), count);
+			Assert::AreEqual('(', *stop);
+		}
+
+		TEST_METHOD(ManyMatrices)
+		{
+			std::string text = Matrix4::identity.ToString() + "\n" + Matrix4::MakeScale(2.f, 3.f, 4.f).ToString() + "\n";
+			Matrix4 out[4];
+			const char* stop = nullptr;
+			Assert::AreEqual(size_t(2), Parse::Many(text.data(), text.data() + text.size(), out, 4, &stop));
+			Assert::AreEqual(Matrix4::MakeScale(2.f, 3.f, 4.f), out[1]);
+			Assert::IsTrue(stop == text.data() + text.size());
+
+			text = Matrix3::identity.ToString() + "\n" + Matrix3::MakeScale(2.f, 3.f).ToString();
+			Matrix3 out3[4];
+			Assert::AreEqual(size_t(2), Parse::Many(text.data(), text.data() + text.size(), out3, 4));
+			Assert::AreEqual(Matrix3::MakeScale(2.f, 3.f), out3[1]);
+		}
+
+		TEST_METHOD(Malformed)
+		{
+			Vector3 v;
+			const char* bad[] = { "(1, 2)", "(1, 2, x)", "1, 2, 3", "(1, 2, 3", "" };
+			for (const char* text : bad)
+			{
+				Assert::IsNull(Parse::Value(text, text + std::strlen(text), v));
+			}
+
+			Colour c;
+			const char* shortHex = "#12345";
+			Assert::IsNull(Parse::Value(shortHex, shortHex + 6, c));
+			const char* rgb = "#102030";
+			Assert::IsNotNull(Parse::Value(rgb, rgb + 7, c));
+			Assert::AreEqual(Colour(0x10, 0x20, 0x30, 0xff), c);
+		}
+	};
+}
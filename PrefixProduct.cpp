@@ -0,0 +1,154 @@
+#include "MathHeaders/PrefixProduct.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
+#include <vector>
+
+namespace MathClasses {
+	namespace {
+		// A running product held in registers between steps, so a chain never reloads what it just
+		// stored. Multiply(a, b) is a * b with operator*'s summation order.
+#if MATHCLASSES_SSE2
+		struct Columns4 {
+			__m128 c0, c1, c2, c3;
+		};
+
+		inline Columns4 Load(const Matrix4& m) {
+			const float* p = &m.m1;
+			return { _mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12) };
+		}
+
+		inline __m128 Column(const Columns4& a, const float* b) {
+			__m128 sum = _mm_mul_ps(_mm_set1_ps(b[0]), a.c0);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(b[1]), a.c1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(b[2]), a.c2));
+			return _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(b[3]), a.c3));
+		}
+
+		inline Columns4 Multiply(const Columns4& a, const Matrix4& b) {
+			const float* p = &b.m1;
+			return { Column(a, p), Column(a, p + 4), Column(a, p + 8), Column(a, p + 12) };
+		}
+
+		inline void Store(const Columns4& a, Matrix4& m) {
+			float* p = &m.m1;
+			_mm_storeu_ps(p, a.c0);
+			_mm_storeu_ps(p + 4, a.c1);
+			_mm_storeu_ps(p + 8, a.c2);
+			_mm_storeu_ps(p + 12, a.c3);
+		}
+
+		// three-float columns, the fourth lane unused
+		struct Columns3 {
+			__m128 c0, c1, c2;
+		};
+
+		inline __m128 Load3(const float* p) {
+			return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p)), _mm_load_ss(p + 2));
+		}
+
+		inline Columns3 Load(const Matrix3& m) {
+			const float* p = &m.m1;
+			return { Load3(p), Load3(p + 3), Load3(p + 6) };
+		}
+
+		inline __m128 Column(const Columns3& a, const float* b) {
+			__m128 sum = _mm_mul_ps(a.c0, _mm_set1_ps(b[0]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a.c1, _mm_set1_ps(b[1])));
+			return _mm_add_ps(sum, _mm_mul_ps(a.c2, _mm_set1_ps(b[2])));
+		}
+
+		inline Columns3 Multiply(const Columns3& a, const Matrix3& b) {
+			const float* p = &b.m1;
+			return { Column(a, p), Column(a, p + 3), Column(a, p + 6) };
+		}
+
+		// each column's spare lane is overwritten by the next; the last is stored as exactly three
+		// floats so nothing past the matrix is touched
+		inline void Store(const Columns3& a, Matrix3& m) {
+			float* p = &m.m1;
+			_mm_storeu_ps(p, a.c0);
+			_mm_storeu_ps(p + 3, a.c1);
+			_mm_storel_pi(reinterpret_cast<__m64*>(p + 6), a.c2);
+			_mm_store_ss(p + 8, _mm_movehl_ps(a.c2, a.c2));
+		}
+#else
+		template <typename Matrix>
+		inline Matrix Load(const Matrix& m) {
+			return m;
+		}
+
+		template <typename Matrix>
+		inline Matrix Multiply(const Matrix& a, const Matrix& b) {
+			return a * b;
+		}
+
+		template <typename Matrix>
+		inline void Store(const Matrix& a, Matrix& m) {
+			m = a;
+		}
+#endif
+
+		// in[0] * ... * in[count - 1]
+		template <typename Matrix>
+		Matrix Total(const Matrix* in, size_t count) {
+			auto product = Load(in[0]);
+			for (size_t i = 1; i < count; ++i) {
+				product = Multiply(product, in[i]);
+			}
+			Matrix result;
+			Store(product, result);
+			return result;
+		}
+
+		// the left fold of in[0 .. count), started from carry when there is one
+		template <typename Matrix>
+		void Fold(const Matrix* in, Matrix* out, size_t count, const Matrix* carry) {
+			auto product = carry ? Multiply(Load(*carry), in[0]) : Load(in[0]);
+			Store(product, out[0]);
+			for (size_t i = 1; i < count; ++i) {
+				product = Multiply(product, in[i]);
+				Store(product, out[i]);
+			}
+		}
+
+		// reduce then scan: block totals in parallel, the carries into each block serially in block
+		// order, then every block folded onto its carry in parallel
+		template <typename Matrix>
+		void Scan(const Matrix* in, Matrix* out, size_t count) {
+			if (count == 0) {
+				return;
+			}
+			size_t blocks = (count + PrefixProductBlock - 1) / PrefixProductBlock;
+			if (blocks == 1) {
+				Fold(in, out, count, static_cast<const Matrix*>(nullptr));
+				return;
+			}
+
+			// carries[b] is the product of every block before b; carries[0] is not used
+			std::vector<Matrix> carries(blocks);
+			Parallel::For(blocks - 1, 1, [&](size_t begin, size_t end) {
+				for (size_t b = begin; b < end; ++b) {
+					carries[b + 1] = Total(in + b * PrefixProductBlock, PrefixProductBlock);
+				}
+			});
+			for (size_t b = 2; b < blocks; ++b) {
+				Store(Multiply(Load(carries[b - 1]), carries[b]), carries[b]);
+			}
+			Parallel::For(blocks, 1, [&](size_t begin, size_t end) {
+				for (size_t b = begin; b < end; ++b) {
+					size_t first = b * PrefixProductBlock;
+					Fold(in + first, out + first, std::min(PrefixProductBlock, count - first), b > 0 ? &carries[b] : nullptr);
+				}
+			});
+		}
+	}
+
+	void PrefixProducts(const Matrix4* in, Matrix4* out, size_t count) {
+		Scan(in, out, count);
+	}
+
+	void PrefixProducts(const Matrix3* in, Matrix3* out, size_t count) {
+		Scan(in, out, count);
+	}
+}
@@ -0,0 +1,92 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/PrefixProduct.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	namespace
+	{
+		// small rotations and steps, so long chains stay well scaled
+		Matrix4 Link4(size_t i)
+		{
+			return Matrix4::MakeEuler(0.01f * (i % 7), -0.02f * (i % 5), 0.015f * (i % 3)) * Matrix4::MakeTranslation(0.1f, 0.0f, -0.05f * (i % 2));
+		}
+
+		Matrix3 Link3(size_t i)
+		{
+			return Matrix3::MakeTranslation(0.1f, -0.05f * (i % 2)) * Matrix3::MakeRotateZ(0.01f * (i % 7));
+		}
+	}
+
+	TEST_CLASS(PrefixProductTests)
+	{
+	public:
+		// within one block the scan is the serial fold, bit for bit
+		TEST_METHOD(ShortChainIsSerialFold)
+		{
+			std::vector<Matrix4> in4(100), out4(100);
+			std::vector<Matrix3> in3(100), out3(100);
+			for (size_t i = 0; i < 100; ++i)
+			{
+				in4[i] = Link4(i);
+				in3[i] = Link3(i);
+			}
+			PrefixProducts(in4.data(), out4.data(), 100);
+			PrefixProducts(in3.data(), out3.data(), 100);
+
+			Matrix4 running4 = in4[0];
+			Matrix3 running3 = in3[0];
+			for (size_t i = 0; i < 100; ++i)
+			{
+				if (i > 0)
+				{
+					running4 = running4 * in4[i];
+					running3 = running3 * in3[i];
+				}
+				Assert::AreEqual(running4, out4[i]);
+				Assert::AreEqual(running3, out3[i]);
+			}
+		}
+		// blocked chains agree with the serial fold to rounding, and are identical for any thread count
+		TEST_METHOD(LongChainReproducible)
+		{
+			const size_t count = PrefixProductBlock * 3 + 17;
+			std::vector<Matrix4> in(count), reference(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				in[i] = Link4(i);
+			}
+
+			Parallel::SetWorkerCount(1);
+			PrefixProducts(in.data(), reference.data(), count);
+			Matrix4 running = in[0];
+			for (size_t i = 1; i < count; ++i)
+			{
+				running = running * in[i];
+				if (i % 500 == 0 || i == count - 1)
+				{
+					Assert::IsTrue(running.Equals(reference[i], 1e-2f));
+				}
+			}
+
+			for (unsigned threads : { 2u, 3u, 7u })
+			{
+				Parallel::SetWorkerCount(threads);
+				std::vector<Matrix4> out(in);
+				PrefixProducts(out.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(reference[i], out[i]);
+				}
+			}
+			Parallel::SetWorkerCount(0);
+		}
+	};
+}
@@ -0,0 +1,191 @@
+#include "MathHeaders/Resample.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/SimdConfig.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace MathClasses {
+	namespace {
+		const double Pi = 3.14159265358979323846;
+
+		float FilterSupport(ResampleFilter filter) {
+			switch (filter) {
+			case ResampleFilter::Box: return 0.5f;
+			case ResampleFilter::Bilinear: return 1.0f;
+			default: return 3.0f;
+			}
+		}
+
+		double Sinc(double x) {
+			if (x == 0.0) {
+				return 1.0;
+			}
+			x *= Pi;
+			return std::sin(x) / x;
+		}
+
+		double FilterWeight(ResampleFilter filter, double x) {
+			switch (filter) {
+			case ResampleFilter::Box:
+				return (x >= -0.5 && x < 0.5) ? 1.0 : 0.0;
+			case ResampleFilter::Bilinear:
+				x = std::fabs(x);
+				return x < 1.0 ? 1.0 - x : 0.0;
+			default:
+				return std::fabs(x) < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0;
+			}
+		}
+
+		// Source taps and normalised weights for every destination pixel along one axis
+		struct FilterTable {
+			size_t taps;
+			std::vector<size_t> first;  // first source index per destination pixel
+			std::vector<float> weights; // taps weights per destination pixel
+		};
+
+		FilterTable MakeFilterTable(size_t srcSize, size_t dstSize, ResampleFilter filter) {
+			double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+			double widen = std::max(scale, 1.0);
+			double support = FilterSupport(filter) * widen;
+
+			FilterTable table;
+			table.taps = std::min(static_cast<size_t>(std::ceil(support * 2.0)) + 1, srcSize);
+			table.first.resize(dstSize);
+			table.weights.assign(dstSize * table.taps, 0.0f);
+
+			std::vector<double> w(table.taps);
+			for (size_t i = 0; i < dstSize; ++i) {
+				double centre = (i + 0.5) * scale;
+				long long left = static_cast<long long>(std::floor(centre - support));
+				left = std::max(0LL, std::min(left, static_cast<long long>(srcSize - table.taps)));
+
+				double sum = 0.0;
+				std::fill(w.begin(), w.end(), 0.0);
+				// taps outside the image are folded onto the nearest edge pixel
+				long long lo = static_cast<long long>(std::floor(centre - support)) - 1;
+				long long hi = static_cast<long long>(std::ceil(centre + support)) + 1;
+				for (long long j = lo; j <= hi; ++j) {
+					double weight = FilterWeight(filter, (j + 0.5 - centre) / widen);
+					if (weight == 0.0) {
+						continue;
+					}
+					long long clamped = std::max(0LL, std::min(j, static_cast<long long>(srcSize) - 1));
+					long long tap = clamped - left;
+					if (tap >= 0 && tap < static_cast<long long>(table.taps)) {
+						w[static_cast<size_t>(tap)] += weight;
+						sum += weight;
+					}
+				}
+
+				table.first[i] = static_cast<size_t>(left);
+				for (size_t t = 0; t < table.taps && sum != 0.0; ++t) {
+					table.weights[i * table.taps + t] = static_cast<float>(w[t] / sum);
+				}
+			}
+			return table;
+		}
+
+#if MATHCLASSES_SSE2
+		// one pixel per register; lanes hold the bytes of the packed value from low to high
+		__m128 LoadPixel(const Colour& c) {
+			__m128i v = _mm_cvtsi32_si128(static_cast<int>(c.colour));
+			__m128i zero = _mm_setzero_si128();
+			return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero));
+		}
+
+		Colour StorePixel(__m128 v) {
+			__m128i i = _mm_cvtps_epi32(v);
+			i = _mm_packs_epi32(i, i);
+			i = _mm_packus_epi16(i, i);
+			Colour c;
+			c.colour = static_cast<uint32_t>(_mm_cvtsi128_si32(i));
+			return c;
+		}
+#else
+		void LoadPixel(const Colour& c, float* out) {
+			for (int ch = 0; ch < 4; ++ch) {
+				out[ch] = static_cast<float>((c.colour >> (ch * 8)) & 0xff);
+			}
+		}
+
+		Colour StorePixel(const float* v) {
+			Colour c;
+			c.colour = 0;
+			for (int ch = 0; ch < 4; ++ch) {
+				long value = std::lrint(v[ch]);
+				value = std::max(0L, std::min(value, 255L));
+				c.colour |= static_cast<uint32_t>(value) << (ch * 8);
+			}
+			return c;
+		}
+#endif
+	}
+
+	void Resample(const Colour* src, size_t srcWidth, size_t srcHeight,
+		Colour* dst, size_t dstWidth, size_t dstHeight, ResampleFilter filter) {
+		if (srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+			return;
+		}
+
+		FilterTable horizontal = MakeFilterTable(srcWidth, dstWidth, filter);
+		FilterTable vertical = MakeFilterTable(srcHeight, dstHeight, filter);
+
+		// horizontal pass into a float image with four channels per pixel
+		std::vector<float> temp(srcHeight * dstWidth * 4);
+		Parallel::For(srcHeight, std::max<size_t>(1, 8192 / dstWidth), [&](size_t rowBegin, size_t rowEnd) {
+			for (size_t y = rowBegin; y < rowEnd; ++y) {
+				const Colour* srcRow = src + y * srcWidth;
+				float* tempRow = &temp[y * dstWidth * 4];
+				for (size_t x = 0; x < dstWidth; ++x) {
+					const Colour* taps = srcRow + horizontal.first[x];
+					const float* weights = &horizontal.weights[x * horizontal.taps];
+#if MATHCLASSES_SSE2
+					__m128 sum = _mm_setzero_ps();
+					for (size_t t = 0; t < horizontal.taps; ++t) {
+						sum = _mm_add_ps(sum, _mm_mul_ps(LoadPixel(taps[t]), _mm_set1_ps(weights[t])));
+					}
+					_mm_storeu_ps(tempRow + x * 4, sum);
+#else
+					float sum[4] = { 0, 0, 0, 0 };
+					for (size_t t = 0; t < horizontal.taps; ++t) {
+						float p[4];
+						LoadPixel(taps[t], p);
+						for (int ch = 0; ch < 4; ++ch) {
+							sum[ch] += p[ch] * weights[t];
+						}
+					}
+					std::copy(sum, sum + 4, tempRow + x * 4);
+#endif
+				}
+			}
+		});
+
+		// vertical pass, split by bands of output rows
+		Parallel::For(dstHeight, std::max<size_t>(1, 8192 / dstWidth), [&](size_t rowBegin, size_t rowEnd) {
+			for (size_t y = rowBegin; y < rowEnd; ++y) {
+				const float* weights = &vertical.weights[y * vertical.taps];
+				const float* firstRow = &temp[vertical.first[y] * dstWidth * 4];
+				Colour* dstRow = dst + y * dstWidth;
+				for (size_t x = 0; x < dstWidth; ++x) {
+					const float* column = firstRow + x * 4;
+#if MATHCLASSES_SSE2
+					__m128 sum = _mm_setzero_ps();
+					for (size_t t = 0; t < vertical.taps; ++t) {
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(column + t * dstWidth * 4), _mm_set1_ps(weights[t])));
+					}
+					dstRow[x] = StorePixel(sum);
+#else
+					float sum[4] = { 0, 0, 0, 0 };
+					for (size_t t = 0; t < vertical.taps; ++t) {
+						for (int ch = 0; ch < 4; ++ch) {
+							sum[ch] += column[t * dstWidth * 4 + ch] * weights[t];
+						}
+					}
+					dstRow[x] = StorePixel(sum);
+#endif
+				}
+			}
+		});
+	}
+}
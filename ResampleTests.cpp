@@ -0,0 +1,81 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Resample.h"
+#include <UnitTestLib.h>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Colour;
+using ::MathClasses::ResampleFilter;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ResampleTests)
+	{
+	public:
+		// halving with a box filter averages 2x2 blocks
+		TEST_METHOD(BoxHalve)
+		{
+			std::vector<Colour> src = {
+				Colour(0, 0, 0, 255), Colour(100, 0, 0, 255), Colour(10, 10, 10, 10), Colour(10, 10, 10, 10),
+				Colour(0, 100, 0, 255), Colour(100, 100, 0, 255), Colour(10, 10, 10, 10), Colour(10, 10, 10, 10) };
+			std::vector<Colour> dst(2);
+
+			MathClasses::Resample(src.data(), 4, 2, dst.data(), 2, 1, ResampleFilter::Box);
+
+			Assert::AreEqual(UnitLib::BuildColour(50, 50, 0, 255), dst[0].colour);
+			Assert::AreEqual(UnitLib::BuildColour(10, 10, 10, 10), dst[1].colour);
+		}
+
+		// growing with a box filter repeats pixels
+		TEST_METHOD(BoxDouble)
+		{
+			std::vector<Colour> src = { Colour(1, 2, 3, 4), Colour(5, 6, 7, 8) };
+			std::vector<Colour> dst(4);
+
+			MathClasses::Resample(src.data(), 2, 1, dst.data(), 4, 1, ResampleFilter::Box);
+
+			Assert::IsTrue(dst[0] == src[0] && dst[1] == src[0]);
+			Assert::IsTrue(dst[2] == src[1] && dst[3] == src[1]);
+		}
+
+		// every filter leaves a flat image unchanged
+		TEST_METHOD(FlatImage)
+		{
+			std::vector<Colour> src(64 * 48, Colour(200, 100, 50, 255));
+			ResampleFilter filters[] = { ResampleFilter::Box, ResampleFilter::Bilinear, ResampleFilter::Lanczos3 };
+
+			for (ResampleFilter filter : filters)
+			{
+				std::vector<Colour> smaller(13 * 7), larger(150 * 90);
+				MathClasses::Resample(src.data(), 64, 48, smaller.data(), 13, 7, filter);
+				MathClasses::Resample(src.data(), 64, 48, larger.data(), 150, 90, filter);
+
+				for (const Colour& c : smaller)
+				{
+					Assert::IsTrue(c == src[0]);
+				}
+				for (const Colour& c : larger)
+				{
+					Assert::IsTrue(c == src[0]);
+				}
+			}
+		}
+
+		// bilinear upscale interpolates between neighbours
+		TEST_METHOD(BilinearGradient)
+		{
+			std::vector<Colour> src = { Colour(0, 0, 0, 255), Colour(200, 0, 0, 255) };
+			std::vector<Colour> dst(4);
+
+			MathClasses::Resample(src.data(), 2, 1, dst.data(), 4, 1, ResampleFilter::Bilinear);
+
+			Assert::AreEqual((uint8_t)0, dst[0].GetRed());
+			Assert::AreEqual((uint8_t)50, dst[1].GetRed());
+			Assert::AreEqual((uint8_t)150, dst[2].GetRed());
+			Assert::AreEqual((uint8_t)200, dst[3].GetRed());
+		}
+	};
+}
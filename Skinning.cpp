@@ -0,0 +1,297 @@
+#include "MathHeaders/Skinning.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/SimdConfig.h"
+#include <cmath>
+#include <vector>
+
+namespace MathClasses {
+	namespace {
+		// vertices per worker range
+		const size_t SkinGrain = 2048;
+
+		// unit rotation quaternion and dual part 0.5 * t * real, components in x, y, z, w order
+		struct alignas(16) DualQuat {
+			float real[4];
+			float dual[4];
+		};
+
+		// the rotation comes from the normalised upper 3x3 columns, so any scale is dropped
+		DualQuat ToDualQuat(const Matrix4& m) {
+			float c0[3] = { m.m1, m.m2, m.m3 }, c1[3] = { m.m5, m.m6, m.m7 }, c2[3] = { m.m9, m.m10, m.m11 };
+			for (float* c : { c0, c1, c2 }) {
+				float length = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+				if (length > 0) {
+					c[0] /= length;
+					c[1] /= length;
+					c[2] /= length;
+				}
+			}
+			// r[row][column] of the rotation applied to column vectors
+			float r00 = c0[0], r10 = c0[1], r20 = c0[2];
+			float r01 = c1[0], r11 = c1[1], r21 = c1[2];
+			float r02 = c2[0], r12 = c2[1], r22 = c2[2];
+
+			float x, y, z, w;
+			float trace = r00 + r11 + r22;
+			if (trace > 0) {
+				float s = std::sqrt(trace + 1.0f) * 2.0f;
+				w = 0.25f * s; x = (r21 - r12) / s; y = (r02 - r20) / s; z = (r10 - r01) / s;
+			}
+			else if (r00 > r11 && r00 > r22) {
+				float s = std::sqrt(1.0f + r00 - r11 - r22) * 2.0f;
+				w = (r21 - r12) / s; x = 0.25f * s; y = (r01 + r10) / s; z = (r02 + r20) / s;
+			}
+			else if (r11 > r22) {
+				float s = std::sqrt(1.0f + r11 - r00 - r22) * 2.0f;
+				w = (r02 - r20) / s; x = (r01 + r10) / s; y = 0.25f * s; z = (r12 + r21) / s;
+			}
+			else {
+				float s = std::sqrt(1.0f + r22 - r00 - r11) * 2.0f;
+				w = (r10 - r01) / s; x = (r02 + r20) / s; y = (r12 + r21) / s; z = 0.25f * s;
+			}
+			float length = std::sqrt(x * x + y * y + z * z + w * w);
+			x /= length; y /= length; z /= length; w /= length;
+
+			float tx = m.m13, ty = m.m14, tz = m.m15;
+			DualQuat q = { { x, y, z, w }, {} };
+			q.dual[0] = 0.5f * (tx * w + ty * z - tz * y);
+			q.dual[1] = 0.5f * (-tx * z + ty * w + tz * x);
+			q.dual[2] = 0.5f * (tx * y - ty * x + tz * w);
+			q.dual[3] = -0.5f * (tx * x + ty * y + tz * z);
+			return q;
+		}
+
+		// The scalar kernels below are the tail and the MATHCLASSES_NO_SIMD path; the SSE2 ones do
+		// the same operations in the same order per lane, so every vertex skins identically.
+
+		void LinearVertex(const SkinInput& in, const Matrix4* palette, const SkinOutput& out, size_t i) {
+			const uint16_t* bones = in.bones + i * 4;
+			const float* weights = in.weights + i * 4;
+			float m[16];
+			const float* first = &palette[bones[0]].m1;
+			for (int k = 0; k < 16; ++k) {
+				m[k] = weights[0] * first[k];
+			}
+			for (int j = 1; j < 4; ++j) {
+				const float* bone = &palette[bones[j]].m1;
+				for (int k = 0; k < 16; ++k) {
+					m[k] = m[k] + weights[j] * bone[k];
+				}
+			}
+
+			float x = in.x[i], y = in.y[i], z = in.z[i];
+			out.x[i] = ((m[0] * x + m[4] * y) + m[8] * z) + m[12];
+			out.y[i] = ((m[1] * x + m[5] * y) + m[9] * z) + m[13];
+			out.z[i] = ((m[2] * x + m[6] * y) + m[10] * z) + m[14];
+			if (in.nx) {
+				float nx = in.nx[i], ny = in.ny[i], nz = in.nz[i];
+				float tx = (m[0] * nx + m[4] * ny) + m[8] * nz;
+				float ty = (m[1] * nx + m[5] * ny) + m[9] * nz;
+				float tz = (m[2] * nx + m[6] * ny) + m[10] * nz;
+				float length = std::sqrt((tx * tx + ty * ty) + tz * tz);
+				if (length > 0) {
+					tx = tx / length;
+					ty = ty / length;
+					tz = tz / length;
+				}
+				out.nx[i] = tx;
+				out.ny[i] = ty;
+				out.nz[i] = tz;
+			}
+		}
+
+		void DualQuatVertex(const SkinInput& in, const DualQuat* dq, const SkinOutput& out, size_t i) {
+			const uint16_t* bones = in.bones + i * 4;
+			const float* weights = in.weights + i * 4;
+			const DualQuat& q0 = dq[bones[0]];
+			float w = weights[0];
+			float bx = w * q0.real[0], by = w * q0.real[1], bz = w * q0.real[2], bw = w * q0.real[3];
+			float dx = w * q0.dual[0], dy = w * q0.dual[1], dz = w * q0.dual[2], dw = w * q0.dual[3];
+			for (int j = 1; j < 4; ++j) {
+				const DualQuat& q = dq[bones[j]];
+				// blend along the shorter arc from the first influence
+				float dot = ((q0.real[0] * q.real[0] + q0.real[1] * q.real[1]) + q0.real[2] * q.real[2]) + q0.real[3] * q.real[3];
+				w = dot < 0 ? -weights[j] : weights[j];
+				bx = bx + w * q.real[0]; by = by + w * q.real[1]; bz = bz + w * q.real[2]; bw = bw + w * q.real[3];
+				dx = dx + w * q.dual[0]; dy = dy + w * q.dual[1]; dz = dz + w * q.dual[2]; dw = dw + w * q.dual[3];
+			}
+			float inverse = 1.0f / std::sqrt(((bx * bx + by * by) + bz * bz) + bw * bw);
+			bx = bx * inverse; by = by * inverse; bz = bz * inverse; bw = bw * inverse;
+			dx = dx * inverse; dy = dy * inverse; dz = dz * inverse; dw = dw * inverse;
+
+			// translation 2 * dual * conjugate(real)
+			float tx = ((dx * bw - dw * bx) + (dz * by - dy * bz)) * 2.0f;
+			float ty = ((dy * bw - dw * by) + (dx * bz - dz * bx)) * 2.0f;
+			float tz = ((dz * bw - dw * bz) + (dy * bx - dx * by)) * 2.0f;
+
+			// v + w c + u x c with c = 2 u x v
+			auto rotate = [&](float vx, float vy, float vz, float& ox, float& oy, float& oz) {
+				float cx = (by * vz - bz * vy) * 2.0f, cy = (bz * vx - bx * vz) * 2.0f, cz = (bx * vy - by * vx) * 2.0f;
+				ox = (vx + bw * cx) + (by * cz - bz * cy);
+				oy = (vy + bw * cy) + (bz * cx - bx * cz);
+				oz = (vz + bw * cz) + (bx * cy - by * cx);
+			};
+			float px, py, pz;
+			rotate(in.x[i], in.y[i], in.z[i], px, py, pz);
+			out.x[i] = px + tx;
+			out.y[i] = py + ty;
+			out.z[i] = pz + tz;
+			if (in.nx) {
+				float nx, ny, nz;
+				rotate(in.nx[i], in.ny[i], in.nz[i], nx, ny, nz);
+				out.nx[i] = nx;
+				out.ny[i] = ny;
+				out.nz[i] = nz;
+			}
+		}
+
+#if MATHCLASSES_SSE2
+		inline __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+		inline __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+		inline __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+
+		// n / |n| where |n| > 0, lane-wise over three component registers
+		inline void Normalise(__m128& x, __m128& y, __m128& z) {
+			__m128 length = _mm_sqrt_ps(Add(Add(Mul(x, x), Mul(y, y)), Mul(z, z)));
+			__m128 positive = _mm_cmpgt_ps(length, _mm_setzero_ps());
+			x = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(x, length)), _mm_andnot_ps(positive, x));
+			y = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(y, length)), _mm_andnot_ps(positive, y));
+			z = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(z, length)), _mm_andnot_ps(positive, z));
+		}
+
+		// Four vertices: each blends its matrix as four column registers, the transformed vectors
+		// are then transposed back into the component streams.
+		void LinearGroup(const SkinInput& in, const Matrix4* palette, const SkinOutput& out, size_t i) {
+			__m128 p[4], n[4];
+			for (int v = 0; v < 4; ++v) {
+				const uint16_t* bones = in.bones + (i + v) * 4;
+				const float* weights = in.weights + (i + v) * 4;
+				__m128 c[4];
+				__m128 w = _mm_set1_ps(weights[0]);
+				const float* bone = &palette[bones[0]].m1;
+				for (int k = 0; k < 4; ++k) {
+					c[k] = Mul(w, _mm_loadu_ps(bone + k * 4));
+				}
+				for (int j = 1; j < 4; ++j) {
+					w = _mm_set1_ps(weights[j]);
+					bone = &palette[bones[j]].m1;
+					for (int k = 0; k < 4; ++k) {
+						c[k] = Add(c[k], Mul(w, _mm_loadu_ps(bone + k * 4)));
+					}
+				}
+				p[v] = Add(Add(Add(Mul(c[0], _mm_set1_ps(in.x[i + v])), Mul(c[1], _mm_set1_ps(in.y[i + v]))),
+					Mul(c[2], _mm_set1_ps(in.z[i + v]))), c[3]);
+				if (in.nx) {
+					n[v] = Add(Add(Mul(c[0], _mm_set1_ps(in.nx[i + v])), Mul(c[1], _mm_set1_ps(in.ny[i + v]))),
+						Mul(c[2], _mm_set1_ps(in.nz[i + v])));
+				}
+			}
+			_MM_TRANSPOSE4_PS(p[0], p[1], p[2], p[3]);
+			_mm_storeu_ps(out.x + i, p[0]);
+			_mm_storeu_ps(out.y + i, p[1]);
+			_mm_storeu_ps(out.z + i, p[2]);
+			if (in.nx) {
+				_MM_TRANSPOSE4_PS(n[0], n[1], n[2], n[3]);
+				Normalise(n[0], n[1], n[2]);
+				_mm_storeu_ps(out.nx + i, n[0]);
+				_mm_storeu_ps(out.ny + i, n[1]);
+				_mm_storeu_ps(out.nz + i, n[2]);
+			}
+		}
+
+		// Four vertices in the lanes: each influence's dual quaternions are gathered with a
+		// transpose, and the blend and transform run component-wise as DualQuatVertex does.
+		void DualQuatGroup(const SkinInput& in, const DualQuat* dq, const SkinOutput& out, size_t i) {
+			const uint16_t* bones = in.bones + i * 4;
+			const float* weights = in.weights + i * 4;
+			__m128 w0 = _mm_loadu_ps(weights), w1 = _mm_loadu_ps(weights + 4), w2 = _mm_loadu_ps(weights + 8), w3 = _mm_loadu_ps(weights + 12);
+			_MM_TRANSPOSE4_PS(w0, w1, w2, w3);
+			const __m128 influenceWeights[4] = { w0, w1, w2, w3 };
+			auto gather = [&](int j, __m128& qx, __m128& qy, __m128& qz, __m128& qw, __m128& ex, __m128& ey, __m128& ez, __m128& ew) {
+				const DualQuat* q[4] = { &dq[bones[j]], &dq[bones[4 + j]], &dq[bones[8 + j]], &dq[bones[12 + j]] };
+				qx = _mm_load_ps(q[0]->real); qy = _mm_load_ps(q[1]->real); qz = _mm_load_ps(q[2]->real); qw = _mm_load_ps(q[3]->real);
+				ex = _mm_load_ps(q[0]->dual); ey = _mm_load_ps(q[1]->dual); ez = _mm_load_ps(q[2]->dual); ew = _mm_load_ps(q[3]->dual);
+				_MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+				_MM_TRANSPOSE4_PS(ex, ey, ez, ew);
+			};
+
+			__m128 q0x, q0y, q0z, q0w, bx, by, bz, bw, dx, dy, dz, dw;
+			gather(0, q0x, q0y, q0z, q0w, dx, dy, dz, dw);
+			__m128 w = influenceWeights[0];
+			bx = Mul(w, q0x); by = Mul(w, q0y); bz = Mul(w, q0z); bw = Mul(w, q0w);
+			dx = Mul(w, dx); dy = Mul(w, dy); dz = Mul(w, dz); dw = Mul(w, dw);
+			for (int j = 1; j < 4; ++j) {
+				__m128 qx, qy, qz, qw, ex, ey, ez, ew;
+				gather(j, qx, qy, qz, qw, ex, ey, ez, ew);
+				// blend along the shorter arc from the first influence
+				__m128 dot = Add(Add(Add(Mul(q0x, qx), Mul(q0y, qy)), Mul(q0z, qz)), Mul(q0w, qw));
+				w = _mm_xor_ps(influenceWeights[j], _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+				bx = Add(bx, Mul(w, qx)); by = Add(by, Mul(w, qy)); bz = Add(bz, Mul(w, qz)); bw = Add(bw, Mul(w, qw));
+				dx = Add(dx, Mul(w, ex)); dy = Add(dy, Mul(w, ey)); dz = Add(dz, Mul(w, ez)); dw = Add(dw, Mul(w, ew));
+			}
+			__m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(Add(Add(Add(Mul(bx, bx), Mul(by, by)), Mul(bz, bz)), Mul(bw, bw))));
+			bx = Mul(bx, inverse); by = Mul(by, inverse); bz = Mul(bz, inverse); bw = Mul(bw, inverse);
+			dx = Mul(dx, inverse); dy = Mul(dy, inverse); dz = Mul(dz, inverse); dw = Mul(dw, inverse);
+
+			const __m128 two = _mm_set1_ps(2.0f);
+			__m128 tx = Mul(Add(Sub(Mul(dx, bw), Mul(dw, bx)), Sub(Mul(dz, by), Mul(dy, bz))), two);
+			__m128 ty = Mul(Add(Sub(Mul(dy, bw), Mul(dw, by)), Sub(Mul(dx, bz), Mul(dz, bx))), two);
+			__m128 tz = Mul(Add(Sub(Mul(dz, bw), Mul(dw, bz)), Sub(Mul(dy, bx), Mul(dx, by))), two);
+
+			auto rotate = [&](__m128& vx, __m128& vy, __m128& vz) {
+				__m128 cx = Mul(Sub(Mul(by, vz), Mul(bz, vy)), two);
+				__m128 cy = Mul(Sub(Mul(bz, vx), Mul(bx, vz)), two);
+				__m128 cz = Mul(Sub(Mul(bx, vy), Mul(by, vx)), two);
+				vx = Add(Add(vx, Mul(bw, cx)), Sub(Mul(by, cz), Mul(bz, cy)));
+				vy = Add(Add(vy, Mul(bw, cy)), Sub(Mul(bz, cx), Mul(bx, cz)));
+				vz = Add(Add(vz, Mul(bw, cz)), Sub(Mul(bx, cy), Mul(by, cx)));
+			};
+			__m128 px = _mm_loadu_ps(in.x + i), py = _mm_loadu_ps(in.y + i), pz = _mm_loadu_ps(in.z + i);
+			rotate(px, py, pz);
+			if (in.nx) {
+				__m128 nx = _mm_loadu_ps(in.nx + i), ny = _mm_loadu_ps(in.ny + i), nz = _mm_loadu_ps(in.nz + i);
+				rotate(nx, ny, nz);
+				_mm_storeu_ps(out.nx + i, nx);
+				_mm_storeu_ps(out.ny + i, ny);
+				_mm_storeu_ps(out.nz + i, nz);
+			}
+			_mm_storeu_ps(out.x + i, Add(px, tx));
+			_mm_storeu_ps(out.y + i, Add(py, ty));
+			_mm_storeu_ps(out.z + i, Add(pz, tz));
+		}
+#endif
+	}
+
+	void Skin(const SkinInput& in, const Matrix4* palette, size_t boneCount, const SkinOutput& out, size_t count, SkinningMode mode) {
+		std::vector<DualQuat> dualQuats;
+		if (mode == SkinningMode::DualQuaternion) {
+			dualQuats.resize(boneCount);
+			for (size_t b = 0; b < boneCount; ++b) {
+				dualQuats[b] = ToDualQuat(palette[b]);
+			}
+		}
+		const DualQuat* dq = dualQuats.data();
+
+		Parallel::For(count, SkinGrain, [&](size_t begin, size_t end) {
+			size_t i = begin;
+#if MATHCLASSES_SSE2
+			for (; i + 4 <= end; i += 4) {
+				if (mode == SkinningMode::Linear) {
+					LinearGroup(in, palette, out, i);
+				}
+				else {
+					DualQuatGroup(in, dq, out, i);
+				}
+			}
+#endif
+			for (; i < end; ++i) {
+				if (mode == SkinningMode::Linear) {
+					LinearVertex(in, palette, out, i);
+				}
+				else {
+					DualQuatVertex(in, dq, out, i);
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,120 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Skinning.h"
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	namespace
+	{
+		// SoA buffers for count vertices along the x axis with +y normals, every influence on bone 0
+		struct Mesh
+		{
+			std::vector<float> x, y, z, nx, ny, nz;
+			std::vector<uint16_t> bones;
+			std::vector<float> weights;
+			std::vector<float> ox, oy, oz, onx, ony, onz;
+
+			explicit Mesh(size_t count)
+				: x(count), y(count, 0.5f), z(count, -1.f), nx(count, 0.f), ny(count, 1.f), nz(count, 0.f),
+				bones(count * 4, 0), weights(count * 4, 0.f),
+				ox(count), oy(count), oz(count), onx(count), ony(count), onz(count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					x[i] = 0.5f * i;
+					weights[i * 4] = 1.f;
+				}
+			}
+
+			void Skin(const Matrix4* palette, size_t boneCount, SkinningMode mode)
+			{
+				SkinInput in;
+				in.x = x.data(); in.y = y.data(); in.z = z.data();
+				in.nx = nx.data(); in.ny = ny.data(); in.nz = nz.data();
+				in.bones = bones.data();
+				in.weights = weights.data();
+				SkinOutput out;
+				out.x = ox.data(); out.y = oy.data(); out.z = oz.data();
+				out.nx = onx.data(); out.ny = ony.data(); out.nz = onz.data();
+				MathClasses::Skin(in, palette, boneCount, out, x.size(), mode);
+			}
+		};
+	}
+
+	TEST_CLASS(SkinningTests)
+	{
+	public:
+		// one bone at full weight is its matrix: positions as points, normals as directions
+		TEST_METHOD(SingleBone)
+		{
+			Matrix4 palette[2] = { Matrix4::MakeIdentity(), Matrix4::MakeTranslation(1.f, 2.f, 3.f) * Matrix4::MakeRotateZ(0.7f) };
+			for (SkinningMode mode : { SkinningMode::Linear, SkinningMode::DualQuaternion })
+			{
+				Mesh mesh(7);
+				for (size_t i = 0; i < 7; ++i)
+				{
+					mesh.bones[i * 4] = 1;
+				}
+				mesh.Skin(palette, 2, mode);
+				for (size_t i = 0; i < 7; ++i)
+				{
+					Vector3 p = palette[1].TransformPoint(Vector3(mesh.x[i], mesh.y[i], mesh.z[i]));
+					Vector3 n = palette[1].TransformDirection(Vector3(0.f, 1.f, 0.f));
+					Assert::AreEqual(p, Vector3(mesh.ox[i], mesh.oy[i], mesh.oz[i]));
+					Assert::AreEqual(n, Vector3(mesh.onx[i], mesh.ony[i], mesh.onz[i]));
+				}
+			}
+		}
+		// halfway between two translations
+		TEST_METHOD(LinearBlend)
+		{
+			Matrix4 palette[2] = { Matrix4::MakeTranslation(1.f, 0.f, 0.f), Matrix4::MakeTranslation(3.f, 0.f, 4.f) };
+			Mesh mesh(5);
+			for (size_t i = 0; i < 5; ++i)
+			{
+				mesh.bones[i * 4 + 1] = 1;
+				mesh.weights[i * 4] = 0.5f;
+				mesh.weights[i * 4 + 1] = 0.5f;
+			}
+			mesh.Skin(palette, 2, SkinningMode::Linear);
+			for (size_t i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(mesh.x[i] + 2.f, mesh.ox[i], MAX_FLOAT_DELTA);
+				Assert::AreEqual(0.5f, mesh.oy[i], MAX_FLOAT_DELTA);
+				Assert::AreEqual(1.f, mesh.oz[i], MAX_FLOAT_DELTA);
+				Assert::AreEqual(1.f, mesh.ony[i], MAX_FLOAT_DELTA);
+			}
+		}
+		// blending 0 and 90 degree twists: dual quaternions give the 45 degree one at full length,
+		// the blended matrix shrinks the point towards the axis
+		TEST_METHOD(DualQuaternionKeepsLength)
+		{
+			Matrix4 palette[2] = { Matrix4::MakeIdentity(), Matrix4::MakeRotateZ(1.5707963f) };
+			Mesh mesh(4);
+			for (size_t i = 0; i < 4; ++i)
+			{
+				mesh.x[i] = 2.f;
+				mesh.y[i] = 0.f;
+				mesh.z[i] = 0.f;
+				mesh.bones[i * 4 + 1] = 1;
+				mesh.weights[i * 4] = 0.5f;
+				mesh.weights[i * 4 + 1] = 0.5f;
+			}
+			Vector3 expected = Matrix4::MakeRotateZ(0.78539816f).TransformPoint(Vector3(2.f, 0.f, 0.f));
+
+			mesh.Skin(palette, 2, SkinningMode::DualQuaternion);
+			Assert::AreEqual(expected, Vector3(mesh.ox[0], mesh.oy[0], mesh.oz[0]));
+			Assert::AreEqual(2.f, std::sqrt(mesh.ox[3] * mesh.ox[3] + mesh.oy[3] * mesh.oy[3]), MAX_FLOAT_DELTA);
+
+			mesh.Skin(palette, 2, SkinningMode::Linear);
+			Assert::AreEqual(std::sqrt(2.f), std::sqrt(mesh.ox[0] * mesh.ox[0] + mesh.oy[0] * mesh.oy[0]), MAX_FLOAT_DELTA);
+		}
+	};
+}
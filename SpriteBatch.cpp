@@ -0,0 +1,66 @@
+#include "MathHeaders/SpriteBatch.h"
+#include "MathHeaders/Parallel.h"
+#include "MathHeaders/SimdConfig.h"
+
+namespace MathClasses {
+	static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex is streamed as five packed floats");
+
+	namespace {
+		// sprites per worker range; below this the threads cost more than they save
+		const size_t SpriteGrain = 8192;
+
+		void BatchRange(const Matrix3* transforms, const Colour* tints, const Vector2& size, SpriteVertex* out, size_t begin, size_t end) {
+			float hx = size.x * 0.5f, hy = size.y * 0.5f;
+			size_t i = begin;
+#if MATHCLASSES_SSE2
+			// one sprite per step with its four corners in the lanes
+			const __m128 cornerX = _mm_setr_ps(-hx, hx, hx, -hx);
+			const __m128 cornerY = _mm_setr_ps(-hy, -hy, hy, hy);
+			const __m128 uv01 = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+			const __m128 uv23 = _mm_setr_ps(1.0f, 1.0f, 0.0f, 1.0f);
+			for (; i < end; ++i) {
+				const float* m = &transforms[i].m1;
+				__m128 a = _mm_loadu_ps(m), b = _mm_loadu_ps(m + 4);
+				// m1 x + m4 y + m7 and m2 x + m5 y + m8, summed as TransformPoint2D does
+				__m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), cornerX),
+					_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), cornerY)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)));
+				__m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), cornerX),
+					_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)), cornerY)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)));
+				__m128 xy01 = _mm_unpacklo_ps(x, y), xy23 = _mm_unpackhi_ps(x, y);
+
+				SpriteVertex* v = out + i * 4;
+				uint32_t tint = tints[i].colour;
+				_mm_storeu_ps(&v[0].x, _mm_movelh_ps(xy01, uv01));
+				v[0].colour.colour = tint;
+				_mm_storeu_ps(&v[1].x, _mm_movehl_ps(uv01, xy01));
+				v[1].colour.colour = tint;
+				_mm_storeu_ps(&v[2].x, _mm_movelh_ps(xy23, uv23));
+				v[2].colour.colour = tint;
+				_mm_storeu_ps(&v[3].x, _mm_movehl_ps(uv23, xy23));
+				v[3].colour.colour = tint;
+			}
+#endif
+			const Vector2 corners[4] = { Vector2(-hx, -hy), Vector2(hx, -hy), Vector2(hx, hy), Vector2(-hx, hy) };
+			const float u[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+			const float v[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+			for (; i < end; ++i) {
+				for (int c = 0; c < 4; ++c) {
+					// TransformPoint2D's arithmetic without its per-point instrument count
+					const Matrix3& m = transforms[i];
+					SpriteVertex& vertex = out[i * 4 + c];
+					vertex.x = m.m1 * corners[c].x + m.m4 * corners[c].y + m.m7;
+					vertex.y = m.m2 * corners[c].x + m.m5 * corners[c].y + m.m8;
+					vertex.u = u[c];
+					vertex.v = v[c];
+					vertex.colour = tints[i];
+				}
+			}
+		}
+	}
+
+	void BatchSprites(const Matrix3* transforms, const Colour* tints, size_t count, const Vector2& size, SpriteVertex* out) {
+		Parallel::For(count, SpriteGrain, [&](size_t begin, size_t end) {
+			BatchRange(transforms, tints, size, out, begin, end);
+		});
+	}
+}
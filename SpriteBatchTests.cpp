@@ -0,0 +1,65 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/SpriteBatch.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(SpriteBatchTests)
+	{
+	public:
+		// corners of a translated, scaled sprite with its uvs and tint
+		TEST_METHOD(Quad)
+		{
+			Matrix3 transform = Matrix3::MakeTranslation(10.f, 20.f) * Matrix3::MakeScale(2.f, 3.f);
+			Colour tint(255, 128, 0, 64);
+			SpriteVertex out[4];
+			BatchSprites(&transform, &tint, 1, Vector2(4.f, 2.f), out);
+
+			const float x[4] = { 6.f, 14.f, 14.f, 6.f };
+			const float y[4] = { 17.f, 17.f, 23.f, 23.f };
+			const float u[4] = { 0.f, 1.f, 1.f, 0.f };
+			const float v[4] = { 0.f, 0.f, 1.f, 1.f };
+			for (int i = 0; i < 4; ++i)
+			{
+				Assert::AreEqual(x[i], out[i].x, MAX_FLOAT_DELTA);
+				Assert::AreEqual(y[i], out[i].y, MAX_FLOAT_DELTA);
+				Assert::AreEqual(u[i], out[i].u);
+				Assert::AreEqual(v[i], out[i].v);
+				Assert::AreEqual(tint, out[i].colour);
+			}
+		}
+		// a batch big enough to be split across threads places every corner as TransformPoint2D does
+		TEST_METHOD(LargeBatch)
+		{
+			const size_t count = 40000;
+			std::vector<Matrix3> transforms(count);
+			std::vector<Colour> tints(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				transforms[i] = Matrix3::MakeTranslation(0.5f * i, -1.f * (i % 100)) * Matrix3::MakeRotateZ(0.001f * i);
+				tints[i] = Colour(uint8_t(i), uint8_t(i >> 8), 7, 255);
+			}
+			std::vector<SpriteVertex> out(count * 4);
+			Vector2 size(8.f, 16.f);
+			BatchSprites(transforms.data(), tints.data(), count, size, out.data());
+
+			const Vector2 corners[4] = { Vector2(-4.f, -8.f), Vector2(4.f, -8.f), Vector2(4.f, 8.f), Vector2(-4.f, 8.f) };
+			for (size_t i = 0; i < count; i += 997)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					Vector2 expected = transforms[i].TransformPoint2D(corners[c]);
+					Assert::AreEqual(expected.x, out[i * 4 + c].x);
+					Assert::AreEqual(expected.y, out[i * 4 + c].y);
+					Assert::AreEqual(tints[i], out[i * 4 + c].colour);
+				}
+			}
+		}
+	};
+}
@@ -5,6 +5,7 @@
 
 #include "CppUnitTestAssert.h"
 
+#include "MathHeaders/Vector2.h"
 #include "MathHeaders/Vector3.h"
 #include "MathHeaders/Vector4.h"
 #include "MathHeaders/Matrix3.h"
@@ -15,12 +16,35 @@ namespace Microsoft {
 	namespace VisualStudio {
 		namespace CppUnitTestFramework
 		{
+			using MathClasses::Vector2;
 			using MathClasses::Vector3;
 			using MathClasses::Vector4;
 			using MathClasses::Matrix3;
 			using MathClasses::Matrix4;
 			using MathClasses::Colour;
 
+			template<> inline std::wstring ToString<Vector2>(const Vector2& t)
+			{
+				auto str = t.ToString();
+
+				// mbstowcs_s will expect space to write L'\0' if it isn't already included
+				// in the src buffer
+				//
+				// we don't expect that with ToString() which returns a std::string, so we
+				// add 1 to the length here
+				//
+				// without it, it will raise a runtime "Invalid parameter" error
+				// 
+				// see https://en.cppreference.com/w/c/string/multibyte/mbstowcs
+				std::wstring ws(str.length()+1, L' ');
+
+				size_t size = 0;
+				mbstowcs_s(&size, &ws[0], ws.length(), str.c_str(), str.length());
+
+				ws.resize(size); // resize to actual fit
+				return ws;
+			}
+
 			template<> inline std::wstring ToString<Vector3>(const Vector3& t)
 			{
 				auto str = t.ToString();
@@ -0,0 +1,138 @@
+#include "MathHeaders/Tonemap.h"
+#include "MathHeaders/ColourSimd.h"
+#include "MathHeaders/Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MathClasses {
+	namespace {
+		using Simd::ToByte;
+
+		// 4x4 Bayer matrix, stored as offsets in 8-bit steps centred on zero
+		const float BayerOffsets[4][4] = {
+			{ (0 + 0.5f) / 16 - 0.5f, (8 + 0.5f) / 16 - 0.5f, (2 + 0.5f) / 16 - 0.5f, (10 + 0.5f) / 16 - 0.5f },
+			{ (12 + 0.5f) / 16 - 0.5f, (4 + 0.5f) / 16 - 0.5f, (14 + 0.5f) / 16 - 0.5f, (6 + 0.5f) / 16 - 0.5f },
+			{ (3 + 0.5f) / 16 - 0.5f, (11 + 0.5f) / 16 - 0.5f, (1 + 0.5f) / 16 - 0.5f, (9 + 0.5f) / 16 - 0.5f },
+			{ (15 + 0.5f) / 16 - 0.5f, (7 + 0.5f) / 16 - 0.5f, (13 + 0.5f) / 16 - 0.5f, (5 + 0.5f) / 16 - 0.5f }
+		};
+
+		// sRGB encode using three square roots instead of pow, within a quarter of an
+		// 8-bit step of LinearToSrgb over [0, 1]
+		float LinearToSrgbFast(float value) {
+			if (value <= 0.0031308f) {
+				return 12.92f * value;
+			}
+			float s1 = std::sqrt(value), s2 = std::sqrt(s1), s3 = std::sqrt(s2);
+			return 0.662002687f * s1 + 0.684122060f * s2 - 0.323583601f * s3 - 0.0225411470f * value;
+		}
+
+		Colour TonemapPixel(const float* rgba, size_t x, size_t y, const TonemapSettings& settings) {
+			uint8_t channels[3];
+			for (int ch = 0; ch < 3; ++ch) {
+				float v = ApplyTonemap(rgba[ch] * settings.exposure, settings.curve);
+				if (settings.srgb) {
+					v = LinearToSrgbFast(v);
+				}
+				if (settings.dither) {
+					v += BayerOffsets[y & 3][x & 3] * (1.0f / 255.0f);
+				}
+				channels[ch] = ToByte(v);
+			}
+			return Colour(channels[0], channels[1], channels[2], ToByte(rgba[3]));
+		}
+
+#if MATHCLASSES_SSE2
+		__m128 Tonemap4(__m128 v, TonemapCurve curve) {
+			__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+			v = _mm_max_ps(v, zero);
+			switch (curve) {
+			case TonemapCurve::Reinhard:
+				v = _mm_div_ps(v, _mm_add_ps(one, v));
+				break;
+			case TonemapCurve::ACES: {
+				__m128 num = _mm_mul_ps(v, _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(2.51f)), _mm_set1_ps(0.03f)));
+				__m128 den = _mm_add_ps(_mm_mul_ps(v, _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(2.43f)), _mm_set1_ps(0.59f))), _mm_set1_ps(0.14f));
+				v = _mm_div_ps(num, den);
+				break;
+			}
+			default:
+				break;
+			}
+			return _mm_min_ps(v, one);
+		}
+
+		__m128 LinearToSrgb4(__m128 v) {
+			__m128 s1 = _mm_sqrt_ps(v), s2 = _mm_sqrt_ps(s1), s3 = _mm_sqrt_ps(s2);
+			__m128 curve = _mm_sub_ps(
+				_mm_add_ps(_mm_mul_ps(s1, _mm_set1_ps(0.662002687f)), _mm_mul_ps(s2, _mm_set1_ps(0.684122060f))),
+				_mm_add_ps(_mm_mul_ps(s3, _mm_set1_ps(0.323583601f)), _mm_mul_ps(v, _mm_set1_ps(0.0225411470f))));
+			__m128 linear = _mm_mul_ps(v, _mm_set1_ps(12.92f));
+			return Simd::Select(_mm_cmple_ps(v, _mm_set1_ps(0.0031308f)), linear, curve);
+		}
+#endif
+	}
+
+	float ApplyTonemap(float value, TonemapCurve curve) {
+		// written so NaN and infinity behave like the SSE2 min/max path
+		value = value > 0.0f ? value : 0.0f;
+		switch (curve) {
+		case TonemapCurve::Reinhard:
+			value = value / (1.0f + value);
+			break;
+		case TonemapCurve::ACES:
+			value = (value * (2.51f * value + 0.03f)) / (value * (2.43f * value + 0.59f) + 0.14f);
+			break;
+		default:
+			break;
+		}
+		return value < 1.0f ? value : 1.0f;
+	}
+
+	float LinearToSrgb(float value) {
+		value = Simd::MinPs(Simd::MaxPs(value, 0.0f), 1.0f);
+		if (value <= 0.0031308f) {
+			return 12.92f * value;
+		}
+		return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	void TonemapToColour(const float* rgba, Colour* out, size_t width, size_t height, const TonemapSettings& settings) {
+		Parallel::For(height, std::max<size_t>(1, 16384 / std::max<size_t>(1, width)), [&](size_t rowBegin, size_t rowEnd) {
+			for (size_t y = rowBegin; y < rowEnd; ++y) {
+				const float* row = rgba + y * width * 4;
+				Colour* outRow = out + y * width;
+				size_t x = 0;
+
+#if MATHCLASSES_SSE2
+				__m128 exposure = _mm_set1_ps(settings.exposure);
+				__m128 dither = settings.dither
+					? _mm_mul_ps(_mm_loadu_ps(BayerOffsets[y & 3]), _mm_set1_ps(1.0f / 255.0f))
+					: _mm_setzero_ps();
+
+				// four pixels per step; x stays a multiple of 4 so the Bayer row lines up
+				for (; x + 4 <= width; x += 4) {
+					__m128 r = _mm_loadu_ps(row + x * 4);
+					__m128 g = _mm_loadu_ps(row + x * 4 + 4);
+					__m128 b = _mm_loadu_ps(row + x * 4 + 8);
+					__m128 a = _mm_loadu_ps(row + x * 4 + 12);
+					_MM_TRANSPOSE4_PS(r, g, b, a);
+
+					r = Tonemap4(_mm_mul_ps(r, exposure), settings.curve);
+					g = Tonemap4(_mm_mul_ps(g, exposure), settings.curve);
+					b = Tonemap4(_mm_mul_ps(b, exposure), settings.curve);
+					if (settings.srgb) {
+						r = LinearToSrgb4(r);
+						g = LinearToSrgb4(g);
+						b = LinearToSrgb4(b);
+					}
+
+					Simd::Pack4(_mm_add_ps(r, dither), _mm_add_ps(g, dither), _mm_add_ps(b, dither), a, outRow + x);
+				}
+#endif
+				for (; x < width; ++x) {
+					outRow[x] = TonemapPixel(row + x * 4, x, y, settings);
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,96 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Tonemap.h"
+#include <cstdlib>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Colour;
+using ::MathClasses::TonemapCurve;
+using ::MathClasses::TonemapSettings;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(TonemapTests)
+	{
+	public:
+		// curves map 0 to 0 and stay below 1
+		TEST_METHOD(Curves)
+		{
+			Assert::AreEqual(0.5f, ApplyTonemap(1.f, TonemapCurve::Reinhard), MAX_FLOAT_DELTA);
+			Assert::AreEqual(1.f, ApplyTonemap(4.f, TonemapCurve::Clamp), MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.f, ApplyTonemap(-2.f, TonemapCurve::ACES), MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.803797f, ApplyTonemap(1.f, TonemapCurve::ACES), 1e-4f);
+			Assert::AreEqual(1.f, ApplyTonemap(1000.f, TonemapCurve::ACES), MAX_FLOAT_DELTA);
+		}
+
+		// exact sRGB curve end points and mid grey
+		TEST_METHOD(Srgb)
+		{
+			Assert::AreEqual(0.f, LinearToSrgb(0.f), MAX_FLOAT_DELTA);
+			Assert::AreEqual(1.f, LinearToSrgb(1.f), MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.735357f, LinearToSrgb(0.5f), 1e-4f);
+		}
+
+		// packed output stays within one 8-bit step of the exact pipeline
+		TEST_METHOD(TonemapMatchesReference)
+		{
+			const size_t width = 37, height = 5;
+			std::vector<float> pixels(width * height * 4);
+			for (size_t i = 0; i < pixels.size(); ++i)
+			{
+				pixels[i] = (i % 4 == 3) ? 0.75f : (rand() % 4000) / 1000.f;
+			}
+
+			TonemapSettings settings;
+			settings.exposure = 1.5f;
+			settings.curve = TonemapCurve::ACES;
+			std::vector<Colour> out(width * height);
+			TonemapToColour(pixels.data(), out.data(), width, height, settings);
+
+			for (size_t i = 0; i < out.size(); ++i)
+			{
+				const float* p = &pixels[i * 4];
+				int expected[3];
+				for (int ch = 0; ch < 3; ++ch)
+				{
+					expected[ch] = (int)(LinearToSrgb(ApplyTonemap(p[ch] * 1.5f, TonemapCurve::ACES)) * 255.f + 0.5f);
+				}
+				Assert::IsTrue(abs(expected[0] - out[i].GetRed()) <= 1);
+				Assert::IsTrue(abs(expected[1] - out[i].GetGreen()) <= 1);
+				Assert::IsTrue(abs(expected[2] - out[i].GetBlue()) <= 1);
+				Assert::AreEqual((uint8_t)191, out[i].GetAlpha());
+			}
+		}
+
+		// dithering a flat image between two levels produces both levels
+		TEST_METHOD(OrderedDither)
+		{
+			const size_t width = 8, height = 8;
+			std::vector<float> pixels(width * height * 4, 1.f);
+			for (size_t i = 0; i < width * height; ++i)
+			{
+				pixels[i * 4] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = 100.5f / 255.f;
+			}
+
+			TonemapSettings settings;
+			settings.curve = TonemapCurve::Clamp;
+			settings.srgb = false;
+			settings.dither = true;
+			std::vector<Colour> out(width * height);
+			TonemapToColour(pixels.data(), out.data(), width, height, settings);
+
+			int low = 0, high = 0;
+			for (const Colour& c : out)
+			{
+				Assert::IsTrue(c.GetRed() == 100 || c.GetRed() == 101);
+				(c.GetRed() == 100 ? low : high)++;
+			}
+			Assert::AreEqual(32, low);
+			Assert::AreEqual(32, high);
+		}
+	};
+}
@@ -0,0 +1,192 @@
+#include "MathHeaders/TransformStore.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace MathClasses {
+	namespace {
+		// BeginFrame has no back buffer open
+		const size_t NoBuffer = ~size_t(0);
+	}
+
+	// One copy of the array. stamps[b] is the frame that last wrote block b as of this buffer's
+	// frame; readers counts the snapshots holding it, on its own cache line since every reader
+	// touches it.
+	struct TransformStore::Buffer {
+		std::vector<Matrix4> data;
+		std::vector<uint64_t> stamps;
+		uint64_t frame = 1;
+		alignas(64) std::atomic<size_t> readers{ 0 };
+	};
+
+	// The writer and the readers meet through current and readers alone. A reader counts itself
+	// on the buffer it read from current and then checks current again; the writer only opens a
+	// buffer that is not current and has no readers. With both sides sequentially consistent,
+	// either the writer sees the reader's count and passes the buffer over, or the reader's check
+	// sees that the buffer is no longer current and lets go without touching its contents.
+
+	TransformStore::TransformStore(size_t count, size_t bufferCount)
+		: count(count), blockCount((count + BlockSize - 1) / BlockSize), bufferCount(std::max<size_t>(bufferCount, 2)),
+		buffers(new Buffer[std::max<size_t>(bufferCount, 2)]), current(0), latestFrame(1), writing(NoBuffer) {
+		for (size_t i = 0; i < this->bufferCount; ++i) {
+			buffers[i].data.assign(count, Matrix4::MakeIdentity());
+			buffers[i].stamps.assign(blockCount, 1);
+		}
+	}
+
+	TransformStore::~TransformStore() = default;
+
+	size_t TransformStore::Size() const {
+		return count;
+	}
+
+	Matrix4* TransformStore::BeginFrame() {
+		if (writing != NoBuffer) {
+			return buffers[writing].data.data();
+		}
+
+		size_t latest = current.load();
+		size_t back = NoBuffer;
+		for (;;) {
+			for (size_t i = 0; i < bufferCount && back == NoBuffer; ++i) {
+				if (i != latest && buffers[i].readers.load() == 0) {
+					back = i;
+				}
+			}
+			if (back != NoBuffer) {
+				break;
+			}
+			std::this_thread::yield();
+		}
+
+		// bring the back buffer up to the latest frame, block by block
+		Buffer& to = buffers[back];
+		const Buffer& from = buffers[latest];
+		for (size_t b = 0; b < blockCount; ++b) {
+			if (from.stamps[b] != to.stamps[b]) {
+				size_t begin = b * BlockSize, end = std::min(begin + BlockSize, count);
+				std::copy(from.data.begin() + begin, from.data.begin() + end, to.data.begin() + begin);
+				to.stamps[b] = from.stamps[b];
+			}
+		}
+		writing = back;
+		return to.data.data();
+	}
+
+	void TransformStore::Set(size_t index, const Matrix4& m) {
+		BeginFrame()[index] = m;
+		MarkDirty(index, index + 1);
+	}
+
+	void TransformStore::MarkDirty(size_t begin, size_t end) {
+		BeginFrame();
+		end = std::min(end, count);
+		if (begin >= end) {
+			return;
+		}
+		uint64_t frame = latestFrame.load(std::memory_order_relaxed) + 1;
+		std::vector<uint64_t>& stamps = buffers[writing].stamps;
+		std::fill(stamps.begin() + begin / BlockSize, stamps.begin() + (end - 1) / BlockSize + 1, frame);
+	}
+
+	uint64_t TransformStore::Publish() {
+		BeginFrame();
+		uint64_t frame = latestFrame.load(std::memory_order_relaxed) + 1;
+		buffers[writing].frame = frame;
+		current.store(writing);
+		latestFrame.store(frame);
+		writing = NoBuffer;
+		return frame;
+	}
+
+	TransformStore::Snapshot TransformStore::Acquire() const {
+		for (;;) {
+			size_t i = current.load();
+			buffers[i].readers.fetch_add(1);
+			if (current.load() == i) {
+				Snapshot snapshot;
+				snapshot.store = this;
+				snapshot.buffer = i;
+				return snapshot;
+			}
+			// the writer published again in between and may already be refilling this buffer
+			buffers[i].readers.fetch_sub(1);
+		}
+	}
+
+	uint64_t TransformStore::LatestFrame() const {
+		return latestFrame.load();
+	}
+
+	void TransformStore::Release(size_t buffer) const {
+		buffers[buffer].readers.fetch_sub(1);
+	}
+
+	TransformStore::Snapshot::Snapshot(Snapshot&& other) noexcept
+		: store(other.store), buffer(other.buffer) {
+		other.store = nullptr;
+	}
+
+	TransformStore::Snapshot& TransformStore::Snapshot::operator=(Snapshot&& other) noexcept {
+		if (this != &other) {
+			if (store) {
+				store->Release(buffer);
+			}
+			store = other.store;
+			buffer = other.buffer;
+			other.store = nullptr;
+		}
+		return *this;
+	}
+
+	TransformStore::Snapshot::~Snapshot() {
+		if (store) {
+			store->Release(buffer);
+		}
+	}
+
+	const Matrix4* TransformStore::Snapshot::Data() const {
+		return store ? store->buffers[buffer].data.data() : nullptr;
+	}
+
+	const Matrix4& TransformStore::Snapshot::operator[](size_t index) const {
+		return store->buffers[buffer].data[index];
+	}
+
+	size_t TransformStore::Snapshot::Size() const {
+		return store ? store->count : 0;
+	}
+
+	uint64_t TransformStore::Snapshot::Frame() const {
+		return store ? store->buffers[buffer].frame : 0;
+	}
+
+	void TransformStore::Snapshot::ForEachChanged(uint64_t since, const std::function<void(size_t, size_t)>& fn) const {
+		if (!store) {
+			return;
+		}
+		const std::vector<uint64_t>& stamps = store->buffers[buffer].stamps;
+		size_t blocks = stamps.size();
+		for (size_t b = 0; b < blocks;) {
+			if (stamps[b] <= since) {
+				++b;
+				continue;
+			}
+			size_t first = b;
+			while (b < blocks && stamps[b] > since) {
+				++b;
+			}
+			fn(first * BlockSize, std::min(b * BlockSize, store->count));
+		}
+	}
+
+	size_t TransformStore::Snapshot::CopyChanged(uint64_t since, Matrix4* dst) const {
+		const Matrix4* src = Data();
+		size_t copied = 0;
+		ForEachChanged(since, [&](size_t begin, size_t end) {
+			std::copy(src + begin, src + end, dst + begin);
+			copied += end - begin;
+		});
+		return copied;
+	}
+}
@@ -0,0 +1,129 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "MathHeaders/TransformStore.h"
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(TransformStoreTests)
+	{
+	public:
+		// a snapshot keeps its frame while the writer publishes newer ones around it
+		TEST_METHOD(SnapshotIsStable)
+		{
+			TransformStore store(100);
+			Assert::AreEqual(uint64_t(1), store.LatestFrame());
+			TransformStore::Snapshot first = store.Acquire();
+			Assert::AreEqual(uint64_t(1), first.Frame());
+			Assert::AreEqual(Matrix4::MakeIdentity(), first[99]);
+
+			Matrix4 moved = Matrix4::MakeTranslation(1.f, 2.f, 3.f);
+			store.Set(42, moved);
+			Assert::AreEqual(uint64_t(2), store.Publish());
+			for (int frame = 0; frame < 5; ++frame)
+			{
+				store.Set(7, Matrix4::MakeScale(frame + 2.f, 1.f, 1.f));
+				store.Publish();
+			}
+
+			Assert::AreEqual(Matrix4::MakeIdentity(), first[42]);
+			Assert::AreEqual(Matrix4::MakeIdentity(), first[7]);
+			TransformStore::Snapshot latest = store.Acquire();
+			Assert::AreEqual(uint64_t(7), latest.Frame());
+			Assert::AreEqual(moved, latest[42]);
+			Assert::AreEqual(Matrix4::MakeScale(6.f, 1.f, 1.f), latest[7]);
+
+			TransformStore::Snapshot taken = std::move(latest);
+			Assert::IsNull(latest.Data());
+			Assert::AreEqual(moved, taken[42]);
+		}
+		// only the blocks written after the given frame are copied, whole blocks at a time
+		TEST_METHOD(CopyChangedSince)
+		{
+			const size_t count = TransformStore::BlockSize * 4 + 10;
+			TransformStore store(count);
+			std::vector<Matrix4> mirror(count);
+			Assert::AreEqual(count, store.Acquire().CopyChanged(0, mirror.data()));
+
+			Matrix4* frame = store.BeginFrame();
+			frame[3] = Matrix4::MakeTranslation(1.f, 0.f, 0.f);
+			frame[count - 1] = Matrix4::MakeTranslation(2.f, 0.f, 0.f);
+			store.MarkDirty(3, 4);
+			store.MarkDirty(count - 1, count);
+			uint64_t seen = store.Publish();
+			store.Set(TransformStore::BlockSize * 2, Matrix4::MakeTranslation(3.f, 0.f, 0.f));
+			store.Publish();
+
+			TransformStore::Snapshot snapshot = store.Acquire();
+			std::vector<std::pair<size_t, size_t>> ranges;
+			snapshot.ForEachChanged(seen, [&](size_t begin, size_t end) { ranges.emplace_back(begin, end); });
+			Assert::AreEqual(size_t(1), ranges.size());
+			Assert::AreEqual(TransformStore::BlockSize * 2, ranges[0].first);
+			Assert::AreEqual(TransformStore::BlockSize * 3, ranges[0].second);
+
+			Assert::AreEqual(TransformStore::BlockSize * 2 + 10, snapshot.CopyChanged(1, mirror.data()));
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(snapshot[i], mirror[i]);
+			}
+			Assert::AreEqual(size_t(0), snapshot.CopyChanged(snapshot.Frame(), mirror.data()));
+		}
+		// readers on other threads only ever see whole frames, in order
+		TEST_METHOD(ConcurrentReaders)
+		{
+			const size_t count = 300;
+			const int frames = 2000;
+			TransformStore store(count);
+			std::atomic<bool> torn(false);
+			std::atomic<bool> finished(false);
+
+			auto reader = [&] {
+				std::vector<Matrix4> mirror(count);
+				uint64_t seen = 0;
+				while (!finished.load())
+				{
+					TransformStore::Snapshot snapshot = store.Acquire();
+					if (snapshot.Frame() < seen)
+					{
+						torn = true;
+					}
+					snapshot.CopyChanged(seen, mirror.data());
+					seen = snapshot.Frame();
+					float expected = seen == 1 ? 1.f : float(seen);
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (snapshot[i].m1 != expected || mirror[i].m1 != expected)
+						{
+							torn = true;
+						}
+					}
+				}
+			};
+			std::thread render(reader), network(reader);
+
+			for (int frame = 2; frame <= frames; ++frame)
+			{
+				Matrix4* data = store.BeginFrame();
+				for (size_t i = 0; i < count; ++i)
+				{
+					data[i] = Matrix4::MakeScale(float(frame), 1.f, 1.f);
+				}
+				store.MarkDirty(0, count);
+				store.Publish();
+			}
+			finished = true;
+			render.join();
+			network.join();
+
+			Assert::IsFalse(torn.load());
+			Assert::AreEqual(uint64_t(frames), store.LatestFrame());
+		}
+	};
+}
@@ -0,0 +1,130 @@
+#include "MathHeaders/Vector2.h"
+#include "MathHeaders/Instrument.h"
+#include "MathHeaders/Format.h"
+#include <cmath>
+#include <string>
+
+namespace MathClasses {
+
+    const float EPSILON = 1e-5f;
+    // Constructors
+    Vector2::Vector2() : x(0), y(0) {}
+
+    Vector2::Vector2(float x2d, float y2d) : x(x2d), y(y2d) {}
+
+    // Addition
+    Vector2 Vector2::operator+(const Vector2& rhs) const {
+        return Vector2(x + rhs.x, y + rhs.y);
+    }
+
+    Vector2& Vector2::operator+=(const Vector2& rhs) {
+        x += rhs.x;
+        y += rhs.y;
+        return *this;
+    }
+
+    // Subtraction
+    Vector2 Vector2::operator-(const Vector2& rhs) const {
+        return Vector2(x - rhs.x, y - rhs.y);
+    }
+
+    Vector2& Vector2::operator-=(const Vector2& rhs) {
+        x -= rhs.x;
+        y -= rhs.y;
+        return *this;
+    }
+
+    // Vector scalar multiplication
+    Vector2 Vector2::operator*(float scalar) const {
+        return Vector2(x * scalar, y * scalar);
+    }
+
+    Vector2 operator*(float scalar, const Vector2& lhs) {
+        return Vector2(lhs.x * scalar, lhs.y * scalar);
+    }
+
+    Vector2& Vector2::operator*=(float scalar) {
+        x *= scalar;
+        y *= scalar;
+        return *this;
+    }
+
+    // Vector scalar division
+    Vector2 Vector2::operator/(float scalar) const {
+        return Vector2(x / scalar, y / scalar);
+    }
+
+    Vector2& Vector2::operator/=(float scalar) {
+        x /= scalar;
+        y /= scalar;
+        return *this;
+    }
+
+    // Magnitude
+    float Vector2::Magnitude() const {
+        return std::sqrt(x * x + y * y);
+    }
+
+    // Magnitude squared
+    float Vector2::MagnitudeSqr() const {
+        return x * x + y * y;
+    }
+
+    // Vector normalization
+    void Vector2::Normalise() {
+        MATHCLASSES_COUNT(Normalise);
+        float m = Magnitude();
+        if (m > 0) {
+            x /= m;
+            y /= m;
+        }
+    }
+
+    Vector2 Vector2::Normalised() const {
+        MATHCLASSES_COUNT(Normalise);
+        float m = Magnitude();
+        if (m > 0) {
+            return Vector2(x / m, y / m);
+        }
+        return Vector2();
+    }
+
+    // Distance
+    float Vector2::Distance(const Vector2& other) const {
+        float diffX = x - other.x;
+        float diffY = y - other.y;
+        return std::sqrt(diffX * diffX + diffY * diffY);
+    }
+
+    // Dot product
+    float Vector2::Dot(const Vector2& other) const {
+        return x * other.x + y * other.y;
+    }
+
+    // Equality operators
+    bool Vector2::operator==(const Vector2& rhs) const {
+        return (std::fabs(x - rhs.x) < EPSILON) &&
+            (std::fabs(y - rhs.y) < EPSILON);
+    }
+
+    bool Vector2::operator!=(const Vector2& rhs) const {
+        return !(*this == rhs);
+    }
+
+    //to string
+    std::string Vector2::ToString() const {
+        MATHCLASSES_COUNT(ToString);
+        return Format::ToString(*this);
+    }
+
+    size_t Vector2::FormatTo(char* buffer, size_t size, int precision) const {
+        int digits = precision < 0 ? 6 : precision;
+        Format::Writer out(buffer, size);
+        out.Put('(');
+        out.Put(x, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(y, std::chars_format::fixed, digits);
+        out.Put(')');
+        return out.Finish();
+    }
+}
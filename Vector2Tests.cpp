@@ -0,0 +1,51 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/Vector2.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Vector2;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(Vector2Tests)
+	{
+	public:
+		TEST_METHOD(DefaultConstructor)
+		{
+			Vector2 vec;
+			Assert::AreEqual(0.f, vec.x);
+			Assert::AreEqual(0.f, vec.y);
+		}
+
+		TEST_METHOD(SpecializedConstructor)
+		{
+			Vector2 vec(1.f, 2.f);
+			Assert::AreEqual(1.f, vec.x);
+			Assert::AreEqual(2.f, vec.y);
+		}
+
+		TEST_METHOD(Arithmetic)
+		{
+			Vector2 a(13.5f, -48.23f), b(5.f, 2.5f);
+			Assert::AreEqual(Vector2(18.5f, -45.73f), a + b);
+			Assert::AreEqual(Vector2(8.5f, -50.73f), a - b);
+			Assert::AreEqual(Vector2(27.f, -96.46f), a * 2.f);
+			Assert::AreEqual(Vector2(27.f, -96.46f), 2.f * a);
+			Assert::AreEqual(Vector2(6.75f, -24.115f), a / 2.f);
+			Assert::AreEqual(-53.075f, a.Dot(b), MAX_FLOAT_DELTA);
+		}
+
+		TEST_METHOD(Magnitude)
+		{
+			Vector2 v(3.f, -4.f);
+			Assert::AreEqual(5.f, v.Magnitude(), MAX_FLOAT_DELTA);
+			Assert::AreEqual(25.f, v.MagnitudeSqr(), MAX_FLOAT_DELTA);
+			Assert::AreEqual(Vector2(0.6f, -0.8f), v.Normalised());
+			Assert::AreEqual(Vector2(0, 0), Vector2().Normalised());
+			Assert::AreEqual(5.f, Vector2(1.f, 1.f).Distance(Vector2(4.f, 5.f)), MAX_FLOAT_DELTA);
+		}
+	};
+}
@@ -1,4 +1,6 @@
 #include "MathHeaders/Vector3.h"
+#include "MathHeaders/Instrument.h"
+#include "MathHeaders/Format.h"
 #include <cmath>
 #include <string>
 
@@ -74,6 +76,7 @@ namespace MathClasses {
 
     // Vector normalization
     void Vector3::Normalise() {
+        MATHCLASSES_COUNT(Normalise);
         float m = Magnitude();
         if (m > 0) {
             x /= m;
@@ -83,6 +86,7 @@ namespace MathClasses {
     }
 
     Vector3 Vector3::Normalised() const {
+        MATHCLASSES_COUNT(Normalise);
         float m = Magnitude();
         if (m > 0) {
             return Vector3(x / m, y / m, z / m);
@@ -125,6 +129,21 @@ namespace MathClasses {
 
     //to string
     std::string Vector3::ToString() const {
-		return "(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")";
-	}
+        MATHCLASSES_COUNT(ToString);
+        return Format::ToString(*this);
+    }
+
+    size_t Vector3::FormatTo(char* buffer, size_t size, int precision) const {
+        // same text std::to_string produced, "%f" is fixed with 6 decimals
+        int digits = precision < 0 ? 6 : precision;
+        Format::Writer out(buffer, size);
+        out.Put('(');
+        out.Put(x, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(y, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(z, std::chars_format::fixed, digits);
+        out.Put(')');
+        return out.Finish();
+    }
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "MathHeaders/Vector4.h"
+#include "MathHeaders/Instrument.h"
+#include "MathHeaders/Format.h"
 #include <cmath>
 #include <string>
 
@@ -79,6 +81,7 @@ namespace MathClasses {
 
     // Vector normalization
     void Vector4::Normalise() {
+        MATHCLASSES_COUNT(Normalise);
         float m = Magnitude();
         if (m > 0) {
             x /= m;
@@ -89,6 +92,7 @@ namespace MathClasses {
     }
 
     Vector4 Vector4::Normalised() const {
+        MATHCLASSES_COUNT(Normalise);
         float m = Magnitude();
         if (m > 0) {
             return Vector4(x / m, y / m, z / m, w / m);
@@ -133,6 +137,23 @@ namespace MathClasses {
 
     //to string
     std::string Vector4::ToString() const {
-        return "(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ", " + std::to_string(w) + ")";
+        MATHCLASSES_COUNT(ToString);
+        return Format::ToString(*this);
+    }
+
+    size_t Vector4::FormatTo(char* buffer, size_t size, int precision) const {
+        // same text std::to_string produced, "%f" is fixed with 6 decimals
+        int digits = precision < 0 ? 6 : precision;
+        Format::Writer out(buffer, size);
+        out.Put('(');
+        out.Put(x, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(y, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(z, std::chars_format::fixed, digits);
+        out.Put(", ");
+        out.Put(w, std::chars_format::fixed, digits);
+        out.Put(')');
+        return out.Finish();
     }
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "MathHeaders/VertexTransform.h"
+#include "MathHeaders/SimdConfig.h"
+#include <cstring>
+
+namespace MathClasses {
+	namespace {
+#if MATHCLASSES_SSE2
+		// attributes may sit at any byte offset: the 8 byte halves go through the unaligned integer
+		// moves and the third float through memcpy, never a dereference of a misaligned float*
+		inline __m128 Load3(const char* p) {
+			int z;
+			std::memcpy(&z, p + 8, sizeof(z));
+			__m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+			return _mm_movelh_ps(xy, _mm_castsi128_ps(_mm_cvtsi32_si128(z)));
+		}
+
+		// writes exactly 12 bytes so the rest of the vertex is never touched
+		inline void Store3(char* p, __m128 v) {
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_castps_si128(v));
+			int z = _mm_cvtsi128_si32(_mm_castps_si128(_mm_movehl_ps(v, v)));
+			std::memcpy(p + 8, &z, sizeof(z));
+		}
+
+		template<bool Point>
+		void Transform(const Matrix4& m, char* p, size_t stride, size_t count) {
+			__m128 c0 = _mm_setr_ps(m.m1, m.m2, m.m3, 0.0f);
+			__m128 c1 = _mm_setr_ps(m.m5, m.m6, m.m7, 0.0f);
+			__m128 c2 = _mm_setr_ps(m.m9, m.m10, m.m11, 0.0f);
+			__m128 c3 = _mm_setr_ps(m.m13, m.m14, m.m15, 0.0f);
+			for (size_t i = 0; i < count; ++i, p += stride) {
+				// every vertex but the last is followed by at least 4 more bytes of buffer, so one
+				// unaligned 16 byte load reads the attribute without a gather
+				__m128 v = i + 1 < count ? _mm_loadu_ps(reinterpret_cast<const float*>(p)) : Load3(p);
+				__m128 r = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0),
+					_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2));
+				if (Point) {
+					r = _mm_add_ps(r, c3);
+				}
+				Store3(p, r);
+			}
+		}
+#else
+		template<bool Point>
+		void Transform(const Matrix4& m, char* p, size_t stride, size_t count) {
+			for (size_t i = 0; i < count; ++i, p += stride) {
+				float v[3];
+				std::memcpy(v, p, sizeof(v));
+				float r[3] = {
+					v[0] * m.m1 + v[1] * m.m5 + v[2] * m.m9,
+					v[0] * m.m2 + v[1] * m.m6 + v[2] * m.m10,
+					v[0] * m.m3 + v[1] * m.m7 + v[2] * m.m11
+				};
+				if (Point) {
+					r[0] += m.m13;
+					r[1] += m.m14;
+					r[2] += m.m15;
+				}
+				std::memcpy(p, r, sizeof(r));
+			}
+		}
+#endif
+	}
+
+	void TransformPoints(const Matrix4& m, void* base, size_t stride, size_t offset, size_t count) {
+		Transform<true>(m, static_cast<char*>(base) + offset, stride, count);
+	}
+
+	void TransformDirections(const Matrix4& m, void* base, size_t stride, size_t offset, size_t count) {
+		Transform<false>(m, static_cast<char*>(base) + offset, stride, count);
+	}
+}
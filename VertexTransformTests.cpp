@@ -0,0 +1,85 @@
+#include "CppUnitTest.h"
+#include "TestToString.h"
+
+#include "Utils.h"
+#include "MathHeaders/VertexTransform.h"
+#include "MathHeaders/Colour.h"
+#include <cstddef>
+#include <cstring>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace MathClasses;
+
+namespace MathLibraryTests
+{
+	namespace
+	{
+		struct Vertex
+		{
+			Vector3 position;
+			Vector3 normal;
+			float u, v;
+			Colour colour;
+		};
+	}
+
+	TEST_CLASS(VertexTransformTests)
+	{
+	public:
+		// positions and normals are transformed in place, the other attributes are left alone
+		TEST_METHOD(InterleavedInPlace)
+		{
+			Matrix4 m = Matrix4::MakeTranslation(1.f, 2.f, 3.f) * Matrix4::MakeRotateZ(0.5f);
+			Vertex vertices[5];
+			for (int i = 0; i < 5; ++i)
+			{
+				vertices[i] = { Vector3(1.f * i, -2.f, 0.5f), Vector3(0.f, 1.f, 0.f), 0.25f * i, 0.75f, Colour(10, 20, 30, 40) };
+			}
+
+			TransformPoints(m, vertices, sizeof(Vertex), offsetof(Vertex, position), 5);
+			TransformDirections(m, vertices, sizeof(Vertex), offsetof(Vertex, normal), 5);
+
+			for (int i = 0; i < 5; ++i)
+			{
+				Vector4 point = m * Vector4(1.f * i, -2.f, 0.5f, 1.f);
+				Vector4 normal = m * Vector4(0.f, 1.f, 0.f, 0.f);
+				Assert::AreEqual(point.x, vertices[i].position.x, MAX_FLOAT_DELTA);
+				Assert::AreEqual(point.y, vertices[i].position.y, MAX_FLOAT_DELTA);
+				Assert::AreEqual(point.z, vertices[i].position.z, MAX_FLOAT_DELTA);
+				Assert::AreEqual(normal.x, vertices[i].normal.x, MAX_FLOAT_DELTA);
+				Assert::AreEqual(normal.y, vertices[i].normal.y, MAX_FLOAT_DELTA);
+				Assert::AreEqual(normal.z, vertices[i].normal.z, MAX_FLOAT_DELTA);
+				Assert::AreEqual(0.25f * i, vertices[i].u);
+				Assert::AreEqual(0.75f, vertices[i].v);
+				Assert::AreEqual(Colour(10, 20, 30, 40), vertices[i].colour);
+			}
+		}
+
+		// packed float3 positions, where the next vertex starts right after z
+		TEST_METHOD(PackedAndUnaligned)
+		{
+			Matrix4 m = Matrix4::MakeScale(2.f, 3.f, 4.f) * Matrix4::MakeTranslation(-1.f, 0.f, 1.f);
+			float packed[3 * 3] = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f };
+			TransformPoints(m, packed, 3 * sizeof(float), 0, 3);
+			Assert::AreEqual(0.f, packed[0], MAX_FLOAT_DELTA);
+			Assert::AreEqual(6.f, packed[1], MAX_FLOAT_DELTA);
+			Assert::AreEqual(16.f, packed[2], MAX_FLOAT_DELTA);
+			Assert::AreEqual(12.f, packed[6], MAX_FLOAT_DELTA);
+			Assert::AreEqual(40.f, packed[8], MAX_FLOAT_DELTA);
+
+			// a 13 byte vertex with the position one byte in
+			unsigned char bytes[13 * 2] = {};
+			float position[3] = { 1.f, 1.f, 1.f };
+			std::memcpy(bytes + 1, position, sizeof(position));
+			std::memcpy(bytes + 14, position, sizeof(position));
+			bytes[0] = 0xAB;
+			bytes[13] = 0xCD;
+			TransformDirections(m, bytes, 13, 1, 2);
+			std::memcpy(position, bytes + 14, sizeof(position));
+			Assert::AreEqual(2.f, position[0], MAX_FLOAT_DELTA);
+			Assert::AreEqual(3.f, position[1], MAX_FLOAT_DELTA);
+			Assert::AreEqual(4.f, position[2], MAX_FLOAT_DELTA);
+			Assert::AreEqual(0xCD, static_cast<int>(bytes[13]));
+		}
+	};
+}